@@ -0,0 +1,93 @@
+#include "AllocationTracker.h"
+#include "OutputFile.h"
+#include <sstream>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const std::string unattributedPhase = "(none)";
+			const char* const unattributedCategory = "(other)";
+		}
+
+		AllocationTracker::Site::Site(const char* category)
+			: previous(currentCategory)
+		{
+			currentCategory = category;
+		}
+
+		AllocationTracker::Site::~Site()
+		{
+			currentCategory = previous;
+		}
+
+		std::atomic<bool> AllocationTracker::enabled{ false };
+		thread_local const std::string* AllocationTracker::currentPhase = nullptr;
+		thread_local const char* AllocationTracker::currentCategory = nullptr;
+		thread_local bool AllocationTracker::recording = false;
+
+		void AllocationTracker::Enable()
+		{
+			enabled = true;
+		}
+
+		bool AllocationTracker::IsEnabled()
+		{
+			return enabled;
+		}
+
+		const std::string* AllocationTracker::EnterPhase(const std::string* phase)
+		{
+			auto previous = currentPhase;
+			currentPhase = phase;
+			return previous;
+		}
+
+		void AllocationTracker::LeavePhase(const std::string* previous)
+		{
+			currentPhase = previous;
+		}
+
+		void AllocationTracker::CountAllocation(std::size_t size)
+		{
+			if (!enabled || recording)
+				return;
+
+			// The bookkeeping below allocates too; those allocations must not be counted or recurse.
+			recording = true;
+			{
+				auto& instance = GetInstance();
+				std::lock_guard<std::mutex> lock{ instance.mutex };
+				auto& totals = instance.totals[{
+					currentPhase == nullptr ? unattributedPhase : *currentPhase,
+					currentCategory == nullptr ? unattributedCategory : currentCategory }];
+				++totals.Count;
+				totals.Bytes += size;
+			}
+			recording = false;
+		}
+
+		void AllocationTracker::Write(const std::string& fileName)
+		{
+			enabled = false;
+			auto& instance = GetInstance();
+			std::ostringstream out;
+			out << "phase\tcategory\tcount\tbytes" << std::endl;
+			{
+				std::lock_guard<std::mutex> lock{ instance.mutex };
+				for (auto& entry : instance.totals)
+					out << entry.first.first << "\t" << entry.first.second << "\t"
+						<< entry.second.Count << "\t" << entry.second.Bytes << std::endl;
+			}
+			OutputFile::Write(fileName, out.str());
+		}
+
+		AllocationTracker& AllocationTracker::GetInstance()
+		{
+			static AllocationTracker instance;
+			return instance;
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#ifdef COM_IMPORT_STATISTICS
+#define COM_IMPORT_ALLOCATION_CONCAT_(lhs, rhs) lhs##rhs
+#define COM_IMPORT_ALLOCATION_CONCAT(lhs, rhs) COM_IMPORT_ALLOCATION_CONCAT_(lhs, rhs)
+#define COM_IMPORT_ALLOCATION_SITE(category) \
+	::Com::Import::AllocationTracker::Site COM_IMPORT_ALLOCATION_CONCAT(allocationSite, __LINE__){ category }
+#else
+#define COM_IMPORT_ALLOCATION_SITE(category) ((void)0)
+#endif
+
+namespace Com
+{
+	namespace Import
+	{
+		class AllocationTracker
+		{
+		public:
+			class Site
+			{
+			private:
+				const char* previous;
+
+			public:
+				Site(const char* category);
+				Site(const Site& rhs) = delete;
+				~Site();
+
+				Site& operator=(const Site& rhs) = delete;
+			};
+
+		private:
+			struct Totals
+			{
+				unsigned long long Count;
+				unsigned long long Bytes;
+			};
+
+			static std::atomic<bool> enabled;
+			static thread_local const std::string* currentPhase;
+			static thread_local const char* currentCategory;
+			static thread_local bool recording;
+			std::mutex mutex;
+			std::map<std::pair<std::string, std::string>, Totals> totals;
+
+		public:
+			static void Enable();
+			static bool IsEnabled();
+			static const std::string* EnterPhase(const std::string* phase);
+			static void LeavePhase(const std::string* previous);
+			static void CountAllocation(std::size_t size);
+			static void Write(const std::string& fileName);
+
+		private:
+			AllocationTracker() = default;
+
+			static AllocationTracker& GetInstance();
+		};
+	}
+}
@@ -1,6 +1,6 @@
 #include "ArgumentNames.h"
-#include <locale>
-#include <codecvt>
+#include "Statistics.h"
+#include "Utf8.h"
 
 namespace Com
 {
@@ -10,28 +10,39 @@ namespace Com
 		{
 			names.resize(argumentCount + 1, nullptr);
 			UINT count = 0;
+			COM_IMPORT_COUNT_CALL("GetNames");
 			auto hr = typeInfo->GetNames(member, names.data(), names.size(), &count);
 			CheckError(hr, __FUNCTION__, "GetNames");
 			names.resize(count);
 			if (names.empty())
 				return;
-			::SysFreeString(names.front());
+			memberName = names.front();
 			names.erase(names.begin());
 		}
 
 		ArgumentNames::~ArgumentNames()
 		{
+			::SysFreeString(memberName);
 			for (auto name : names)
 				::SysFreeString(name);
 		}
 
+		bool ArgumentNames::HasMemberName() const
+		{
+			return memberName != nullptr;
+		}
+
+		std::string ArgumentNames::GetMemberName() const
+		{
+			return Utf8::ToString(memberName);
+		}
+
 		std::string ArgumentNames::operator[](UINT index) const
 		{
+			COM_IMPORT_ALLOCATION_SITE("ArgumentNames::operator[]");
 			if (index >= names.size())
 				return "value";
-			return names[index] == nullptr ?
-				"" :
-				std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(names[index]);
+			return Utf8::ToString(names[index]);
 		}
 	}
 }
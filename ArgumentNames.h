@@ -10,6 +10,7 @@ namespace Com
 		class ArgumentNames
 		{
 		private:
+			BSTR memberName = nullptr;
 			std::vector<BSTR> names;
 
 		public:
@@ -19,6 +20,8 @@ namespace Com
 
 			ArgumentNames& operator=(const ArgumentNames& rhs) = delete;
 
+			bool HasMemberName() const;
+			std::string GetMemberName() const;
 			std::string operator[](UINT index) const;
 		};
 	}
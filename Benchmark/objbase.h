@@ -0,0 +1,122 @@
+#pragma once
+// Minimal stand-in for the Windows SDK objbase.h, used only by the Linux build of the benchmarks in
+// this directory. It declares just the OLE Automation types, constants and BSTR functions that the
+// data types, formatters and UTF-8 conversion use, with the sizes they have on Windows.
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+
+typedef std::uint8_t BYTE;
+typedef std::uint16_t WORD;
+typedef std::uint32_t DWORD;
+typedef std::int32_t LONG;
+typedef std::uint32_t ULONG;
+typedef std::int32_t INT;
+typedef std::uint32_t UINT;
+typedef std::int16_t SHORT;
+typedef std::uint16_t USHORT;
+typedef LONG HRESULT;
+typedef DWORD LCID;
+typedef LONG MEMBERID;
+typedef LONG DISPID;
+typedef USHORT VARTYPE;
+typedef wchar_t OLECHAR;
+typedef OLECHAR* BSTR;
+
+struct GUID
+{
+	std::uint32_t Data1;
+	std::uint16_t Data2;
+	std::uint16_t Data3;
+	std::uint8_t Data4[8];
+};
+
+typedef GUID IID;
+typedef GUID CLSID;
+
+const IID IID_IUnknown = { 0x00000000, 0x0000, 0x0000, { 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46 } };
+const IID IID_IDispatch = { 0x00020400, 0x0000, 0x0000, { 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46 } };
+
+inline bool operator==(const GUID& lhs, const GUID& rhs)
+{
+	return std::memcmp(&lhs, &rhs, sizeof(GUID)) == 0;
+}
+
+inline bool operator!=(const GUID& lhs, const GUID& rhs)
+{
+	return !(lhs == rhs);
+}
+
+enum VARENUM
+{
+	VT_EMPTY = 0,
+	VT_NULL = 1,
+	VT_I2 = 2,
+	VT_I4 = 3,
+	VT_R4 = 4,
+	VT_R8 = 5,
+	VT_CY = 6,
+	VT_DATE = 7,
+	VT_BSTR = 8,
+	VT_DISPATCH = 9,
+	VT_ERROR = 10,
+	VT_BOOL = 11,
+	VT_VARIANT = 12,
+	VT_UNKNOWN = 13,
+	VT_DECIMAL = 14,
+	VT_I1 = 16,
+	VT_UI1 = 17,
+	VT_UI2 = 18,
+	VT_UI4 = 19,
+	VT_I8 = 20,
+	VT_UI8 = 21,
+	VT_INT = 22,
+	VT_UINT = 23,
+	VT_ARRAY = 0x2000,
+	VT_BYREF = 0x4000
+};
+
+// Writes the GUID in braces with upper-case digits and returns the characters written, including the terminator.
+inline int StringFromGUID2(const GUID& value, OLECHAR* buffer, int size)
+{
+	auto length = std::swprintf(buffer, size, L"{%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+		value.Data1, value.Data2, value.Data3, value.Data4[0], value.Data4[1], value.Data4[2],
+		value.Data4[3], value.Data4[4], value.Data4[5], value.Data4[6], value.Data4[7]);
+	return length < 0 ? 0 : length + 1;
+}
+
+#define DISPATCH_METHOD 0x1
+#define DISPATCH_PROPERTYGET 0x2
+#define DISPATCH_PROPERTYPUT 0x4
+#define DISPATCH_PROPERTYPUTREF 0x8
+
+// BSTRs keep their length in bytes in the four bytes before the text, as the real ones do.
+inline BSTR SysAllocStringLen(const OLECHAR* text, UINT length)
+{
+	auto block = static_cast<char*>(std::malloc(sizeof(UINT) + (length + 1) * sizeof(OLECHAR)));
+	if (block == nullptr)
+		return nullptr;
+	auto byteLength = static_cast<UINT>(length * sizeof(OLECHAR));
+	std::memcpy(block, &byteLength, sizeof(byteLength));
+	auto result = reinterpret_cast<BSTR>(block + sizeof(UINT));
+	if (text != nullptr)
+		std::memcpy(result, text, length * sizeof(OLECHAR));
+	result[length] = 0;
+	return result;
+}
+
+inline void SysFreeString(BSTR text)
+{
+	if (text != nullptr)
+		std::free(reinterpret_cast<char*>(text) - sizeof(UINT));
+}
+
+inline UINT SysStringLen(BSTR text)
+{
+	if (text == nullptr)
+		return 0;
+	UINT byteLength;
+	std::memcpy(&byteLength, reinterpret_cast<char*>(text) - sizeof(UINT), sizeof(byteLength));
+	return byteLength / sizeof(OLECHAR);
+}
@@ -0,0 +1,73 @@
+#include "BenchmarkSettings.h"
+#ifdef _WIN32
+#include "ImportBenchmark.h"
+#endif
+#include "FormatterBenchmark.h"
+#include "TranscodingBenchmark.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void DisplayHelp()
+{
+	std::cout << "C++ COM Import Tool Benchmarks" << std::endl
+		<< "Usages:" << std::endl
+#ifdef _WIN32
+		<< "    Com.Import.Benchmark.exe import interfaces=1000 functions=10 parameters=3 records=100" << std::endl
+		<< "        enums=100 coclasses=100 references=10 libraries=1 iterations=1 implement=0" << std::endl
+		<< "        low_memory=0" << std::endl
+		<< "    - Synthesizes a type library trace with the given counts, replays it through the loader" << std::endl
+		<< "      and code generator, and prints throughput and peak working set as JSON. Generated files" << std::endl
+		<< "      are written to the current directory. With low_memory=1 each library is written and" << std::endl
+		<< "      released as it is decoded, as with --low-memory." << std::endl
+		<< std::endl
+#endif
+		<< "    Com.Import.Benchmark.exe formatters size=medium iterations=5 mode=Interface" << std::endl
+		<< "    - Builds a library in memory (size is tiny, small, medium or office; the counts of the" << std::endl
+		<< "      import benchmark override it) and times every formatter mode whose name contains the" << std::endl
+		<< "      mode filter, printing ns per function and bytes per second as JSON." << std::endl
+		<< std::endl
+		<< "    Com.Import.Benchmark.exe transcoding names=100000 length=16 non_ascii=5 iterations=5" << std::endl
+		<< "    - Converts generated UTF-16 names (non_ascii per thousand contain a non-ASCII character)" << std::endl
+		<< "      to UTF-8 with wstring_convert and with the scalar and SIMD kernels, checks they agree and" << std::endl
+		<< "      prints ns per name as JSON." << std::endl
+		<< std::endl;
+}
+
+void RunBenchmark(const std::string& name, const Com::Import::BenchmarkSettings& settings)
+{
+#ifdef _WIN32
+	if (name == "import")
+	{
+		Com::Import::ImportBenchmark::Run(settings, std::cout);
+		return;
+	}
+#endif
+	if (name == "formatters")
+		Com::Import::FormatterBenchmark::Run(settings, std::cout);
+	else if (name == "transcoding")
+		Com::Import::TranscodingBenchmark::Run(settings, std::cout);
+	else
+		throw std::runtime_error("Unknown benchmark: " + name);
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		if (argc < 2)
+		{
+			DisplayHelp();
+			return 0;
+		}
+		Com::Import::BenchmarkSettings settings{ std::vector<std::string>(argv + 2, argv + argc) };
+		RunBenchmark(argv[1], settings);
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << exception.what() << std::endl;
+		return -1;
+	}
+	return 0;
+}
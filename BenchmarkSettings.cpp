@@ -0,0 +1,45 @@
+#include "BenchmarkSettings.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		BenchmarkSettings::BenchmarkSettings(const std::vector<std::string>& arguments)
+		{
+			for (auto& argument : arguments)
+			{
+				auto separator = argument.find('=');
+				if (separator == std::string::npos || separator == 0)
+					throw std::runtime_error("Benchmark settings must be of the form name=value: " + argument);
+				values[argument.substr(0, separator)] = argument.substr(separator + 1);
+			}
+		}
+
+		unsigned long BenchmarkSettings::GetNumber(const std::string& name, unsigned long defaultValue) const
+		{
+			auto found = values.find(name);
+			if (found == values.end())
+				return defaultValue;
+			std::size_t end = 0;
+			auto value = std::stoul(found->second, &end);
+			if (end != found->second.size())
+				throw std::runtime_error("Benchmark setting " + name + " must be a number: " + found->second);
+			return value;
+		}
+
+		std::string BenchmarkSettings::GetString(const std::string& name, const std::string& defaultValue) const
+		{
+			auto found = values.find(name);
+			return found == values.end() ? defaultValue : found->second;
+		}
+
+		void BenchmarkSettings::CheckNames(const std::vector<std::string>& names) const
+		{
+			for (auto& value : values)
+				if (std::find(names.begin(), names.end(), value.first) == names.end())
+					throw std::runtime_error("Unknown benchmark setting: " + value.first);
+		}
+	}
+}
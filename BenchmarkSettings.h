@@ -0,0 +1,25 @@
+#pragma once
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class BenchmarkSettings
+		{
+		private:
+			std::map<std::string, std::string> values;
+
+		public:
+			BenchmarkSettings() = default;
+			BenchmarkSettings(const std::vector<std::string>& arguments);
+
+			unsigned long GetNumber(const std::string& name, unsigned long defaultValue) const;
+			std::string GetString(const std::string& name, const std::string& defaultValue) const;
+			void CheckNames(const std::vector<std::string>& names) const;
+		};
+	}
+}
@@ -1,5 +1,15 @@
 #include "CoclassFormatter.h"
 #include "InterfaceFormatter.h"
+#include "FragmentCache.h"
+#include "FunctionFormatter.h"
+#include "PerfectHash.h"
+#include "HexFormatter.h"
+#include "GuidFormatter.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
 
 namespace Com
 {
@@ -9,8 +19,10 @@ namespace Com
 			const Coclass& value,
 			CoclassFormat format,
 			const std::string& libraryName,
-			const std::string& outputName)
-			: value(value), format(format), libraryName(libraryName), outputName(outputName)
+			const std::string& outputName,
+			const std::vector<Interface>* libraryInterfaces,
+			FragmentCache* fragments)
+			: value(value), format(format), libraryName(libraryName), outputName(outputName), libraryInterfaces(libraryInterfaces), fragments(fragments)
 		{
 		}
 
@@ -42,7 +54,37 @@ namespace Com
 				if (iface.IsConflicting)
 					out << Format(iface, InterfaceFormat::AsResolveNameConflict, value.Name + "_");
 			out << "	template <typename Type>" << std::endl
-				<< "	class " << value.Name << "Coclass : public Com::Object<Type, &CLSID_" << value.Name;
+				<< "	class " << value.Name << "Coclass : public ";
+			WriteObjectBase(out);
+			out << std::endl
+				<< "	{" << std::endl
+				<< "	public:" << std::endl;
+			for (auto& iface : value.Interfaces)
+				WriteInterface(out, iface, InterfaceFormat::AsCoclassAbstractFunctions, "");
+			for (auto& iface : value.Interfaces)
+				WriteInterface(out, iface, InterfaceFormat::AsRawFunctions, "");
+			if (!value.Interfaces.empty())
+				WriteQueryInterface(out);
+			auto dispatchInterface = GetDispatchInterface();
+			if (dispatchInterface != nullptr)
+			{
+				WriteGetIdsOfNames(out, *dispatchInterface);
+				WriteInvoke(out, *dispatchInterface);
+			}
+			out << "	};" << std::endl;
+		}
+
+		void CoclassFormatter::WriteInterface(std::ostream& out, const Interface& iface, InterfaceFormat format, const std::string& scope) const
+		{
+			if (fragments != nullptr)
+				fragments->Write(out, iface, format, "", scope);
+			else
+				out << Format(iface, format, "", scope);
+		}
+
+		void CoclassFormatter::WriteObjectBase(std::ostream& out) const
+		{
+			out << "Com::Object<Type, &CLSID_" << value.Name;
 			for (auto& iface : value.Interfaces)
 			{
 				out << ", ";
@@ -50,14 +92,212 @@ namespace Com
 					out << value.Name << "_";
 				out << iface.Name;
 			}
-			out << ">" << std::endl
-				<< "	{" << std::endl
-				<< "	public:" << std::endl;
+			out << ">";
+		}
+
+		void CoclassFormatter::WriteGetIdsOfNames(std::ostream& out, const Interface& iface) const
+		{
+			// Sorted by folded name so the table reads the same as the case-insensitive lookup.
+			std::map<std::u16string, std::pair<std::u16string, MEMBERID>> sortedNames;
+			for (auto& function : iface.Functions)
+			{
+				if (!IsInvokable(iface, function))
+					continue;
+				auto name = Utf8::ToUtf16(function.RootName);
+				auto folded = name;
+				for (auto& unit : folded)
+					if (unit >= u'A' && unit <= u'Z')
+						unit += u'a' - u'A';
+				sortedNames.emplace(folded, std::make_pair(name, function.MemberId));
+			}
+			std::vector<std::u16string> keys;
+			for (auto& entry : sortedNames)
+				keys.push_back(entry.second.first);
+			PerfectHash hash{ keys };
+
+			out << "		HRESULT __stdcall GetIDsOfNames(REFIID riid, LPOLESTR* names, UINT count, LCID locale, DISPID* ids) override" << std::endl
+				<< "		{" << std::endl
+				<< "			static constexpr Com::Import::Dispatch::Name dispatchNames[] =" << std::endl
+				<< "			{" << std::endl;
+			for (auto& entry : sortedNames)
+			{
+				out << "				{ ";
+				WriteWideLiteral(out, entry.second.first);
+				out << ", ";
+				if (entry.second.second >= 0)
+					out << Hex(static_cast<unsigned int>(entry.second.second));
+				else
+					out << entry.second.second;
+				out << " }," << std::endl;
+			}
+			out << "			};" << std::endl;
+			WriteTable(out, "dispatchSeeds", hash.GetSeeds());
+			WriteTable(out, "dispatchSlots", hash.GetSlots());
+			out << "			if (Com::Import::Dispatch::TryFindName(dispatchNames, dispatchSeeds, dispatchSlots, names, count, ids))" << std::endl
+				<< "				return S_OK;" << std::endl
+				<< "			using Base = ";
+			WriteObjectBase(out);
+			out << ";" << std::endl
+				<< "			return Base::GetIDsOfNames(riid, names, count, locale, ids);" << std::endl
+				<< "		}" << std::endl;
+		}
+
+		void CoclassFormatter::WriteInvoke(std::ostream& out, const Interface& iface) const
+		{
+			std::map<MEMBERID, std::vector<const Function*>> functionsById;
+			for (auto& function : iface.Functions)
+				if (IsInvokable(iface, function))
+					functionsById[function.MemberId].push_back(&function);
+
+			out << "		HRESULT __stdcall Invoke(DISPID invokeMember, REFIID invokeInterface, LCID invokeLocale, WORD invokeFlags, "
+				<< "DISPPARAMS* invokeParameters, VARIANT* invokeResult, EXCEPINFO* invokeException, UINT* invokeArgumentError) override" << std::endl
+				<< "		{" << std::endl
+				<< "			if (Com::Import::Dispatch::IsPositional(invokeParameters, invokeFlags))" << std::endl
+				<< "			{" << std::endl
+				<< "				switch (invokeMember)" << std::endl
+				<< "				{" << std::endl;
+			auto prefix = iface.IsConflicting ? iface.Name + "_" : "";
+			for (auto& entry : functionsById)
+			{
+				out << Format(*entry.second.front(), FunctionFormat::AsInvokeCase);
+				for (auto function : entry.second)
+					out << Format(*function, FunctionFormat::AsInvokeBranch, prefix);
+				out << "					break;" << std::endl;
+			}
+			out << "				}" << std::endl
+				<< "			}" << std::endl
+				<< "			using Base = ";
+			WriteObjectBase(out);
+			out << ";" << std::endl
+				<< "			return Base::Invoke(invokeMember, invokeInterface, invokeLocale, invokeFlags, invokeParameters, invokeResult, invokeException, invokeArgumentError);" << std::endl
+				<< "		}" << std::endl;
+		}
+
+		void CoclassFormatter::WriteQueryInterface(std::ostream& out) const
+		{
+			// Each IID maps to the interface it names and the listed interface it is reached through,
+			// which keeps IUnknown, IDispatch and shared bases unambiguous.
+			std::vector<std::pair<GUID, std::string>> entries;
+			auto add = [&](const GUID& iid, const std::string& name, const std::string& path)
+			{
+				auto found = std::find_if(entries.begin(), entries.end(), [&](const std::pair<GUID, std::string>& entry)
+				{
+					return std::memcmp(&entry.first, &iid, sizeof(GUID)) == 0;
+				});
+				if (found == entries.end())
+					entries.emplace_back(iid, "Com::Import::Interfaces::Cast<" + name + ", " + path + ", " + value.Name + "Coclass>");
+			};
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsCoclassAbstractFunctions);
+			{
+				auto path = iface.IsConflicting ? value.Name + "_" + iface.Name : iface.Name;
+				add(iface.Iid, iface.Name, path);
+				auto current = &iface;
+				while (current != nullptr && current->Base != "IUnknown" && current->Base != "IDispatch")
+				{
+					add(current->BaseIid, current->Base, path);
+					current = FindLibraryInterface(current->Base);
+				}
+				if (iface.SupportsDispatch || (current != nullptr && current->Base == "IDispatch"))
+					add(IID_IDispatch, "IDispatch", path);
+			}
+			auto& first = value.Interfaces.front();
+			add(IID_IUnknown, "IUnknown", first.IsConflicting ? value.Name + "_" + first.Name : first.Name);
+			std::sort(entries.begin(), entries.end(), [](const std::pair<GUID, std::string>& lhs, const std::pair<GUID, std::string>& rhs)
+			{
+				return std::memcmp(&lhs.first, &rhs.first, sizeof(GUID)) < 0;
+			});
+
+			out << "		HRESULT __stdcall QueryInterface(REFIID riid, void** ppvObject) override" << std::endl
+				<< "		{" << std::endl
+				<< "			static constexpr Com::Import::Interfaces::Entry<" << value.Name << "Coclass> interfaces[] =" << std::endl
+				<< "			{" << std::endl;
+			for (auto& entry : entries)
+				out << "				{ " << Format(entry.first, GuidFormat::AsInitializer) << ", &" << entry.second << " }," << std::endl;
+			out << "			};" << std::endl
+				<< "			auto found = ppvObject == nullptr ? nullptr : Com::Import::Interfaces::Find(interfaces, this, riid);" << std::endl
+				<< "			if (found != nullptr)" << std::endl
+				<< "			{" << std::endl
+				<< "				found->AddRef();" << std::endl
+				<< "				*ppvObject = found;" << std::endl
+				<< "				return S_OK;" << std::endl
+				<< "			}" << std::endl
+				<< "			using Base = ";
+			WriteObjectBase(out);
+			out << ";" << std::endl
+				<< "			return Base::QueryInterface(riid, ppvObject);" << std::endl
+				<< "		}" << std::endl;
+		}
+
+		const Interface* CoclassFormatter::FindLibraryInterface(const std::string& name) const
+		{
+			if (libraryInterfaces == nullptr)
+				return nullptr;
+			auto found = std::find_if(libraryInterfaces->begin(), libraryInterfaces->end(), [&](const Interface& iface){ return iface.Name == name; });
+			return found == libraryInterfaces->end() ? nullptr : &*found;
+		}
+
+		void CoclassFormatter::WriteTable(std::ostream& out, const char* name, const std::vector<unsigned short>& values)
+		{
+			out << "			static constexpr unsigned short " << name << "[] = { ";
+			for (std::size_t index = 0; index < values.size(); ++index)
+			{
+				if (index > 0)
+					out << ", ";
+				out << values[index];
+			}
+			out << " };" << std::endl;
+		}
+
+		void CoclassFormatter::WriteWideLiteral(std::ostream& out, const std::u16string& value)
+		{
+			out << "L\"";
+			for (std::size_t index = 0; index < value.size(); ++index)
+			{
+				unsigned long code = value[index];
+				if (code >= 0x20 && code < 0x7F && code != '\\' && code != '"')
+				{
+					out << static_cast<char>(code);
+					continue;
+				}
+				if (code >= 0xD800 && code < 0xDC00 && index + 1 < value.size())
+					code = 0x10000 + ((code - 0xD800) << 10) + (value[++index] - 0xDC00);
+				out << (code < 0x10000 ? "\\u" : "\\U") << std::hex << std::setfill('0')
+					<< std::setw(code < 0x10000 ? 4 : 8) << code << std::dec;
+			}
+			out << "\"";
+		}
+
+		const Interface* CoclassFormatter::GetDispatchInterface() const
+		{
+			// Like a type information based IDispatch, the table serves the first dispatch interface only.
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsRawFunctions);
-			out << "	};" << std::endl;
+				if (iface.SupportsDispatch)
+					return std::any_of(iface.Functions.begin(), iface.Functions.end(), [&](const Function& function){ return IsInvokable(iface, function); }) ?
+						&iface :
+						nullptr;
+			return nullptr;
+		}
+
+		bool CoclassFormatter::IsInvokable(const Interface& iface, const Function& function)
+		{
+			if (function.VtblOffset < iface.VtblOffset || function.Retval.TypeEnum != TypeEnum::Hresult)
+				return false;
+			return std::all_of(function.ArgList.begin(), function.ArgList.end(), [](const Parameter& argument)
+			{
+				if (argument.Type.IsArray)
+					return false;
+				switch (argument.Type.TypeEnum)
+				{
+				case TypeEnum::Record:
+				case TypeEnum::Guid:
+				case TypeEnum::Void:
+				case TypeEnum::StringPtrA:
+				case TypeEnum::StringPtrW:
+					return false;
+				default:
+					return true;
+				}
+			});
 		}
 
 		void CoclassFormatter::WriteAsObjectHeader(std::ostream& out) const
@@ -71,7 +311,7 @@ namespace Com
 				<< "	{" << std::endl
 				<< "	public:" << std::endl;
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsCoclassFunctionPrototypes);
+				WriteInterface(out, iface, InterfaceFormat::AsCoclassFunctionPrototypes, "");
 			out << "	};" << std::endl
 				<< "}" << std::endl;
 		}
@@ -83,7 +323,7 @@ namespace Com
 				<< "namespace " << libraryName << std::endl
 				<< "{" << std::endl;
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsCoclassFunctionImplementations, "", value.Name);
+				WriteInterface(out, iface, InterfaceFormat::AsCoclassFunctionImplementations, value.Name);
 			out << "}" << std::endl;
 		}
 
@@ -91,9 +331,11 @@ namespace Com
 			const Coclass& value,
 			CoclassFormat format,
 			const std::string& libraryName,
-			const std::string& outputName)
+			const std::string& outputName,
+			const std::vector<Interface>* libraryInterfaces,
+			FragmentCache* fragments)
 		{
-			return{ value, format, libraryName, outputName };
+			return{ value, format, libraryName, outputName, libraryInterfaces, fragments };
 		}
 	}
 }
@@ -1,11 +1,14 @@
 #pragma once
 #include "DataTypes.h"
+#include "InterfaceFormatter.h"
 #include <iostream>
 
 namespace Com
 {
 	namespace Import
 	{
+		class FragmentCache;
+
 		enum class CoclassFormat
 		{
 			AsBase,
@@ -20,13 +23,17 @@ namespace Com
 			CoclassFormat format;
 			std::string libraryName;
 			std::string outputName;
+			const std::vector<Interface>* libraryInterfaces;
+			FragmentCache* fragments;
 
 		public:
 			CoclassFormatter(
 				const Coclass& value,
 				CoclassFormat format,
 				const std::string& libraryName,
-				const std::string& outputName);
+				const std::string& outputName,
+				const std::vector<Interface>* libraryInterfaces,
+				FragmentCache* fragments);
 
 			std::ostream& Write(std::ostream& out) const;
 			friend std::ostream& operator<<(std::ostream& out, const CoclassFormatter& value);
@@ -35,12 +42,25 @@ namespace Com
 			void WriteAsBase(std::ostream& out) const;
 			void WriteAsObjectHeader(std::ostream& out) const;
 			void WriteAsObjectSource(std::ostream& out) const;
+			void WriteInterface(std::ostream& out, const Interface& iface, InterfaceFormat format, const std::string& scope) const;
+			void WriteObjectBase(std::ostream& out) const;
+			void WriteGetIdsOfNames(std::ostream& out, const Interface& iface) const;
+			void WriteInvoke(std::ostream& out, const Interface& iface) const;
+			void WriteQueryInterface(std::ostream& out) const;
+			const Interface* FindLibraryInterface(const std::string& name) const;
+			const Interface* GetDispatchInterface() const;
+
+			static void WriteTable(std::ostream& out, const char* name, const std::vector<unsigned short>& values);
+			static void WriteWideLiteral(std::ostream& out, const std::u16string& value);
+			static bool IsInvokable(const Interface& iface, const Function& function);
 		};
 
 		CoclassFormatter Format(
 			const Coclass& value,
 			CoclassFormat format,
 			const std::string& libraryName = "",
-			const std::string& outputName = "");
+			const std::string& outputName = "",
+			const std::vector<Interface>* libraryInterfaces = nullptr,
+			FragmentCache* fragments = nullptr);
 	}
 }
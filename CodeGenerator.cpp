@@ -2,7 +2,12 @@
 #include "CoclassFormatter.h"
 #include "LibraryFormatter.h"
 #include "GuidFormatter.h"
-#include <fstream>
+#include "OutputFile.h"
+#include "Statistics.h"
+#include "TraceEvents.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 #include <chrono>
 #include <ctime>
 
@@ -10,12 +15,19 @@ namespace Com
 {
 	namespace Import
 	{
-		void CodeGenerator::Generate(const LoadLibraryResult& result, bool implement)
+		void CodeGenerator::Generate(const LoadLibraryResult& result, const GeneratorOptions& options)
 		{
-			GenerateImport(result.PrimaryLibrary, implement);
+			COM_IMPORT_TIME_PHASE("format and write");
+			GenerateImport(result.PrimaryLibrary, options);
+			auto referenceOptions = GetReferenceOptions(options);
 			for (auto& reference : result.ReferencedLibraries)
-				GenerateImport(reference, false);
-			if (!implement)
+				GenerateImport(reference, referenceOptions);
+			GenerateImplementation(result, options);
+		}
+
+		void CodeGenerator::GenerateImplementation(const LoadLibraryResult& result, const GeneratorOptions& options)
+		{
+			if (!options.Implement)
 				return;
 			GenerateSolution(result);
 			GenerateProject(result);
@@ -33,19 +45,62 @@ namespace Com
 			}
 		}
 
-		void CodeGenerator::GenerateImport(const Library& library, bool implement)
+		GeneratorOptions CodeGenerator::GetReferenceOptions(const GeneratorOptions& options)
+		{
+			auto referenceOptions = options;
+			referenceOptions.Implement = false;
+			return referenceOptions;
+		}
+
+		void CodeGenerator::Summarize(Library& library)
+		{
+			// Keeps what GenerateImplementation and GenerateDependencies read from referenced libraries.
+			Library summary;
+			summary.Name = std::move(library.Name);
+			summary.OutputName = std::move(library.OutputName);
+			summary.FileName = std::move(library.FileName);
+			summary.Libid = library.Libid;
+			summary.MajorVersion = library.MajorVersion;
+			summary.MinorVersion = library.MinorVersion;
+			library = std::move(summary);
+		}
+
+		void CodeGenerator::GenerateDependencies(const std::string& fileName, const LoadLibraryResult& result) const
+		{
+			std::cout << "Generating dependencies: " << fileName << std::endl;
+			std::ostringstream out;
+			auto first = true;
+			for (auto& outputFile : outputFiles)
+			{
+				if (!first)
+					out << " ";
+				first = false;
+				out << EscapeDependency(outputFile);
+			}
+			out << ": \\" << std::endl << "  " << EscapeDependency(GetTypeLibraryPath(result.PrimaryLibrary.FileName));
+			for (auto& reference : result.ReferencedLibraries)
+				out << " \\" << std::endl << "  " << EscapeDependency(GetTypeLibraryPath(reference.FileName));
+			out << std::endl;
+			WriteFile(fileName, out.str());
+		}
+
+		void CodeGenerator::GenerateImport(const Library& library, const GeneratorOptions& options)
 		{
 			auto fileName = library.OutputName + ".h";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating import: " << fileName << std::endl;
-			std::ofstream{ fileName.c_str() } << Format(library, LibraryFormat::AsImport, implement);
+			std::ostringstream out;
+			out << Format(library, LibraryFormat::AsImport, options);
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateSolution(const LoadLibraryResult& result)
 		{
 			auto fileName = result.PrimaryLibrary.Name + ".sln";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating solution: " << fileName << std::endl;
-			std::ofstream{ fileName.c_str() }
-				<< "Microsoft Visual Studio Solution File, Format Version 12.00" << std::endl
+			std::ostringstream out;
+			out << "Microsoft Visual Studio Solution File, Format Version 12.00" << std::endl
 				<< "# Visual Studio 14" << std::endl
 				<< "VisualStudioVersion = 14.0.24720.0" << std::endl
 				<< "MinimumVisualStudioVersion = 10.0.40219.1" << std::endl
@@ -67,13 +122,15 @@ namespace Com
 				<< "		HideSolutionNode = FALSE" << std::endl
 				<< "	EndGlobalSection" << std::endl
 				<< "EndGlobal" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateProject(const LoadLibraryResult& result)
 		{
 			auto fileName = result.PrimaryLibrary.Name + ".vcxproj";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating project: " << fileName << std::endl;
-			std::ofstream out{ fileName.c_str() };
+			std::ostringstream out;
 			out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl
 				<< "<Project DefaultTargets=\"Build\" ToolsVersion=\"14.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << std::endl
 				<< "  <ItemGroup Label=\"ProjectConfigurations\">" << std::endl
@@ -190,13 +247,15 @@ namespace Com
 					<< "Text=\"$([System.String]::Format('$(ErrorText)', 'packages\\Jmfb.Com.1.0.6\\build\\native\\Jmfb.Com.targets'))\" />" << std::endl
 				<< "  </Target>" << std::endl
 				<< "</Project>" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateProjectFilters(const LoadLibraryResult& result)
 		{
 			auto fileName = result.PrimaryLibrary.Name + ".vcxproj.filters";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating filters: " << fileName << std::endl;
-			std::ofstream out{ fileName.c_str() };
+			std::ostringstream out;
 			out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl
 				<< "<Project ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << std::endl
 				<< "  <ItemGroup>" << std::endl
@@ -253,25 +312,29 @@ namespace Com
 				<< "    </ResourceCompile>" << std::endl
 				<< "  </ItemGroup>" << std::endl
 				<< "</Project>" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GeneratePackages()
 		{
 			auto fileName = "packages.config";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating packages: " << fileName << std::endl;
-			std::ofstream{ fileName }
-				<< "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl
+			std::ostringstream out;
+			out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << std::endl
 				<< "<packages>" << std::endl
 				<< "	<package id=\"Jmfb.Com\" version=\"1.0.6\" targetFramework=\"native\" />" << std::endl
 				<< "</packages>" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateResourceHeader(const Library& library)
 		{
 			auto fileName = "resource.h";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generate resource header: " << fileName << std::endl;
-			std::ofstream{ fileName }
-				<< "//{{NO_DEPENDENCIES}}" << std::endl
+			std::ostringstream out;
+			out << "//{{NO_DEPENDENCIES}}" << std::endl
 				<< "// Microsoft Visual C++ generated include file." << std::endl
 				<< "// Used by " << library.Name << ".rc" << std::endl
 				<< std::endl
@@ -285,18 +348,20 @@ namespace Com
 				<< "#define _APS_NEXT_SYMED_VALUE           101" << std::endl
 				<< "#endif" << std::endl
 				<< "#endif" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateResources(const Library& library)
 		{
 			auto fileName = library.Name + ".rc";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generate resources: " << fileName << std::endl;
 
 			auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 			auto year = std::localtime(&time)->tm_year + 1900;
 
-			std::ofstream{ fileName.c_str() }
-				<< "// Microsoft Visual C++ generated resource script." << std::endl
+			std::ostringstream out;
+			out << "// Microsoft Visual C++ generated resource script." << std::endl
 				<< "//" << std::endl
 				<< "#include \"resource.h\"" << std::endl
 				<< std::endl
@@ -396,24 +461,28 @@ namespace Com
 				<< "#endif    // not APSTUDIO_INVOKED" << std::endl
 				<< std::endl
 				<< std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateDef(const Library& library)
 		{
 			auto fileName = library.Name + ".def";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generate module definition: " << fileName << std::endl;
-			std::ofstream{ fileName.c_str() }
-				<< "LIBRARY \"" << library.OutputName << "\"" << std::endl
+			std::ostringstream out;
+			out << "LIBRARY \"" << library.OutputName << "\"" << std::endl
 				<< "EXPORTS" << std::endl
 				<< "	DllCanUnloadNow private" << std::endl
 				<< "	DllGetClassObject private" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateManifest(const Library& library)
 		{
 			auto fileName = library.OutputName + ".manifest";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating manifest: " << fileName << std::endl;
-			std::ofstream out{ fileName.c_str() };
+			std::ostringstream out;
 			out << "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\"?>" << std::endl
 				<< "<assembly" << std::endl
 				<< "	xmlns=\"urn:schemas-microsoft-com:asm.v1\"" << std::endl
@@ -444,15 +513,23 @@ namespace Com
 					<< "		tlbid=\"{" << Format(library.Libid, GuidFormat::AsString) << "}\" />" << std::endl;
 			}
 			out << "</assembly>" << std::endl;
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateMain(const Library& library)
 		{
-			std::cout << "Generating source: main.cpp" << std::endl;
-			std::ofstream out{ "main.cpp" };
+			auto fileName = "main.cpp";
+			TraceEvents::Span span{ "emit", fileName };
+			std::cout << "Generating source: " << fileName << std::endl;
+			std::ostringstream out;
 			out << "#include <Com/Com.h>" << std::endl;
 			for (auto& coclass : library.Coclasses)
 				out << "#include \"" << coclass.Name << ".h\"" << std::endl;
+			out << "#include <algorithm>" << std::endl
+				<< "#include <cstring>" << std::endl
+				<< "#include <iterator>" << std::endl
+				<< std::endl;
+			GenerateClassTable(out, library);
 			out << std::endl
 				<< "extern \"C\" BOOL __stdcall DllMain(HINSTANCE instance, DWORD reason, void* reserved)" << std::endl
 				<< "{" << std::endl
@@ -468,32 +545,128 @@ namespace Com
 				<< std::endl
 				<< "HRESULT __stdcall DllGetClassObject(REFCLSID rclsid, REFIID riid, void** ppvObject)" << std::endl
 				<< "{" << std::endl
-				<< "	return Com::ObjectList<" << std::endl;
-			auto first = true;
+				<< "	if (ppvObject == nullptr)" << std::endl
+				<< "		return E_POINTER;" << std::endl
+				<< "	*ppvObject = nullptr;" << std::endl
+				<< "	auto index = FindClass(rclsid);" << std::endl
+				<< "	if (index == classCount)" << std::endl
+				<< "		return CLASS_E_CLASSNOTAVAILABLE;" << std::endl
+				<< "	return classes[index].Create(rclsid, riid, ppvObject);" << std::endl
+				<< "}" << std::endl;
+			Write(fileName, out.str());
+		}
+
+		void CodeGenerator::GenerateClassTable(std::ostream& out, const Library& library)
+		{
+			std::vector<const Coclass*> sorted;
 			for (auto& coclass : library.Coclasses)
+				sorted.push_back(&coclass);
+			// Sorted by the in-memory bytes of the CLSID, which is the order the generated lookup compares in.
+			std::sort(sorted.begin(), sorted.end(), [](const Coclass* lhs, const Coclass* rhs)
 			{
-				if (!first)
-					out << "," << std::endl;
-				first = false;
-				out << "		" << library.Name << "::" << coclass.Name;
-			}
-			out << std::endl
-				<< "	>::Create(rclsid, riid, ppvObject);" << std::endl
+				return std::memcmp(&lhs->Clsid, &rhs->Clsid, sizeof(GUID)) < 0;
+			});
+
+			out << "namespace" << std::endl
+				<< "{" << std::endl
+				<< "	struct ClassEntry" << std::endl
+				<< "	{" << std::endl
+				<< "		const CLSID* Clsid;" << std::endl
+				<< "		HRESULT (*Create)(REFCLSID rclsid, REFIID riid, void** ppvObject);" << std::endl
+				<< "	};" << std::endl
+				<< std::endl
+				<< "	constexpr ClassEntry classes[] =" << std::endl
+				<< "	{" << std::endl;
+			for (auto coclass : sorted)
+				out << "		{ &" << library.Name << "::CLSID_" << coclass->Name
+					<< ", &Com::ObjectList<" << library.Name << "::" << coclass->Name << ">::Create }," << std::endl;
+			if (sorted.empty())
+				out << "		{ &CLSID_NULL, nullptr }" << std::endl;
+			out << "	};" << std::endl
+				<< "	constexpr std::size_t classCount = " << sorted.size() << ";" << std::endl
+				<< std::endl
+				<< "	bool IsLess(const CLSID& lhs, const CLSID& rhs)" << std::endl
+				<< "	{" << std::endl
+				<< "		return std::memcmp(&lhs, &rhs, sizeof(CLSID)) < 0;" << std::endl
+				<< "	}" << std::endl
+				<< std::endl
+				<< "	std::size_t FindClass(REFCLSID rclsid)" << std::endl
+				<< "	{" << std::endl
+				<< "		auto end = std::begin(classes) + classCount;" << std::endl
+				<< "		auto found = std::lower_bound(std::begin(classes), end, rclsid, [](const ClassEntry& lhs, const CLSID& rhs)" << std::endl
+				<< "		{" << std::endl
+				<< "			return IsLess(*lhs.Clsid, rhs);" << std::endl
+				<< "		});" << std::endl
+				<< "		if (found == end || IsLess(rclsid, *found->Clsid))" << std::endl
+				<< "			return classCount;" << std::endl
+				<< "		return found - std::begin(classes);" << std::endl
+				<< "	}" << std::endl
 				<< "}" << std::endl;
 		}
 
 		void CodeGenerator::GenerateCoclassHeader(const Library& library, const Coclass& coclass)
 		{
 			auto fileName = coclass.Name + ".h";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating header: " << fileName << std::endl;
-			std::ofstream{ fileName.c_str() } << Format(coclass, CoclassFormat::AsObjectHeader, library.Name, library.OutputName);
+			std::ostringstream out;
+			out << Format(coclass, CoclassFormat::AsObjectHeader, library.Name, library.OutputName, nullptr, &fragments);
+			Write(fileName, out.str());
 		}
 
 		void CodeGenerator::GenerateCoclassSource(const Library& library, const Coclass& coclass)
 		{
 			auto fileName = coclass.Name + ".cpp";
+			TraceEvents::Span span{ "emit", fileName };
 			std::cout << "Generating source: " << fileName << std::endl;
-			std::ofstream{ fileName.c_str() } << Format(coclass, CoclassFormat::AsObjectSource, library.Name);
+			std::ostringstream out;
+			out << Format(coclass, CoclassFormat::AsObjectSource, library.Name, "", nullptr, &fragments);
+			Write(fileName, out.str());
+		}
+
+		void CodeGenerator::Write(const std::string& fileName, const std::string& content)
+		{
+			COM_IMPORT_TIME_PHASE("write");
+			COM_IMPORT_COUNT_OUTPUT(fileName, content.size());
+			outputFiles.push_back(fileName);
+			WriteFile(fileName, content);
+		}
+
+		void CodeGenerator::WriteFile(const std::string& fileName, const std::string& content)
+		{
+			if (!OutputFile::Write(fileName, content))
+				std::cout << "Unchanged: " << fileName << std::endl;
+		}
+
+		std::string CodeGenerator::GetTypeLibraryPath(const std::string& fileName)
+		{
+			auto lastSlash = fileName.rfind('\\');
+			if (lastSlash == std::string::npos || lastSlash + 1 == fileName.size())
+				return fileName;
+			auto resourceIndex = fileName.substr(lastSlash + 1);
+			if (resourceIndex.find_first_not_of("0123456789") != std::string::npos)
+				return fileName;
+			return fileName.substr(0, lastSlash);
+		}
+
+		std::string CodeGenerator::EscapeDependency(const std::string& fileName)
+		{
+			std::string result;
+			for (auto character : fileName)
+			{
+				switch (character)
+				{
+				case ' ':
+				case '#':
+					result += '\\';
+					break;
+				case '$':
+					result += '$';
+					break;
+				}
+				result += character;
+			}
+			return result;
 		}
 	}
 };
@@ -1,5 +1,10 @@
 #pragma once
 #include "DataTypes.h"
+#include "Options.h"
+#include "FragmentCache.h"
+#include <iostream>
+#include <string>
+#include <vector>
 
 namespace Com
 {
@@ -7,22 +12,36 @@ namespace Com
 	{
 		class CodeGenerator
 		{
+		private:
+			std::vector<std::string> outputFiles;
+			FragmentCache fragments;
+
 		public:
-			static void Generate(const LoadLibraryResult& result, bool implement);
+			void Generate(const LoadLibraryResult& result, const GeneratorOptions& options);
+			void GenerateImport(const Library& library, const GeneratorOptions& options);
+			void GenerateImplementation(const LoadLibraryResult& result, const GeneratorOptions& options);
+			void GenerateDependencies(const std::string& fileName, const LoadLibraryResult& result) const;
+			static GeneratorOptions GetReferenceOptions(const GeneratorOptions& options);
+			static void Summarize(Library& library);
 
 		private:
-			static void GenerateImport(const Library& library, bool implement);
-			static void GenerateSolution(const LoadLibraryResult& result);
-			static void GenerateProject(const LoadLibraryResult& result);
-			static void GenerateProjectFilters(const LoadLibraryResult& result);
-			static void GeneratePackages();
-			static void GenerateResourceHeader(const Library& library);
-			static void GenerateResources(const Library& library);
-			static void GenerateDef(const Library& library);
-			static void GenerateManifest(const Library& library);
-			static void GenerateMain(const Library& library);
-			static void GenerateCoclassHeader(const Library& library, const Coclass& coclass);
-			static void GenerateCoclassSource(const Library& library, const Coclass& coclass);
+			void GenerateSolution(const LoadLibraryResult& result);
+			void GenerateProject(const LoadLibraryResult& result);
+			void GenerateProjectFilters(const LoadLibraryResult& result);
+			void GeneratePackages();
+			void GenerateResourceHeader(const Library& library);
+			void GenerateResources(const Library& library);
+			void GenerateDef(const Library& library);
+			void GenerateManifest(const Library& library);
+			void GenerateMain(const Library& library);
+			static void GenerateClassTable(std::ostream& out, const Library& library);
+			void GenerateCoclassHeader(const Library& library, const Coclass& coclass);
+			void GenerateCoclassSource(const Library& library, const Coclass& coclass);
+
+			void Write(const std::string& fileName, const std::string& content);
+			static void WriteFile(const std::string& fileName, const std::string& content);
+			static std::string GetTypeLibraryPath(const std::string& fileName);
+			static std::string EscapeDependency(const std::string& fileName);
 		};
 	}
 }
@@ -0,0 +1,65 @@
+#include "CommandLine.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		bool CommandLine::TryParse(int argc, char** argv, Options& options)
+		{
+			for (auto index = 1; index < argc; ++index)
+			{
+				std::string argument = argv[index];
+				if (argument == "/implement")
+					options.Generator.Implement = true;
+				else if (argument == "--bstr-wrappers")
+					options.Generator.BstrWrappers = true;
+				else if (argument == "--safearray-views")
+					options.Generator.SafeArrayViews = true;
+				else if (argument == "--hresult-wrappers")
+					options.Generator.HresultWrappers = true;
+				else if (argument == "--diff")
+				{
+					options.DiffOldFileName = GetValue(argc, argv, index);
+					options.DiffNewFileName = GetValue(argc, argv, index);
+				}
+				else if (argument == "--emit-changed")
+					options.EmitChanged = true;
+				else if (argument == "--low-memory")
+					options.LowMemory = true;
+				else if (argument == "--depfile")
+					options.DependencyFileName = GetValue(argc, argv, index);
+				else if (argument == "--stats")
+					options.ReportStatistics = true;
+				else if (argument == "--trace")
+					options.TraceFileName = GetValue(argc, argv, index);
+				else if (argument == "--allocations")
+					options.AllocationsFileName = GetValue(argc, argv, index);
+				else if (argument == "--record")
+					options.RecordFileName = GetValue(argc, argv, index);
+				else if (argument == "--replay")
+					options.ReplayFileName = GetValue(argc, argv, index);
+				else if (argument.compare(0, 2, "--") == 0)
+					throw std::runtime_error("Unknown option: " + argument);
+				else if (options.TypeLibraryFileName.empty())
+					options.TypeLibraryFileName = argument;
+				// Any other argument is ignored, as it always has been, so existing command lines keep working.
+			}
+			if (!options.RecordFileName.empty() && !options.ReplayFileName.empty())
+				throw std::runtime_error("The --record and --replay options cannot be combined.");
+			if (options.EmitChanged && options.DiffOldFileName.empty())
+				throw std::runtime_error("The --emit-changed option requires --diff.");
+			if (!options.DiffOldFileName.empty() && !options.TypeLibraryFileName.empty())
+				throw std::runtime_error("The --diff option cannot be combined with a type library to import.");
+			return !options.TypeLibraryFileName.empty() || !options.DiffOldFileName.empty();
+		}
+
+		std::string CommandLine::GetValue(int argc, char** argv, int& index)
+		{
+			if (index + 1 >= argc)
+				throw std::runtime_error(std::string{ "Missing value for option: " } + argv[index]);
+			return argv[++index];
+		}
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Options.h"
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class CommandLine
+		{
+		public:
+			static bool TryParse(int argc, char** argv, Options& options);
+
+		private:
+			static std::string GetValue(int argc, char** argv, int& index);
+		};
+	}
+}
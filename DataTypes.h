@@ -1,5 +1,7 @@
 #pragma once
+#include "InternedString.h"
 #include <objbase.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,7 +18,7 @@ namespace Com
 		struct EnumValue
 		{
 			std::string Name;
-			long Value;
+			LONG Value;
 		};
 
 		struct Enum
@@ -31,7 +33,7 @@ namespace Com
 			std::string NewName;
 		};
 
-		enum class TypeEnum
+		enum class TypeEnum : unsigned char
 		{
 			Enum,
 			Interface,
@@ -70,34 +72,36 @@ namespace Com
 		struct Type
 		{
 			int Indirection;
-			TypeEnum TypeEnum;
-			std::string CustomName;
+			Import::TypeEnum TypeEnum;
+			InternedString CustomName;
 			bool IsArray;
 			unsigned long ArraySize;
+			// Element type of a SafeArray, Empty when the element type has no typed view.
+			Import::TypeEnum ElementType;
 		};
 
 		struct Parameter
 		{
-			std::string Name;
-			Type Type;
-			bool In;
-			bool Out;
-			bool Retval;
+			InternedString Name;
+			Import::Type Type;
+			bool In : 1;
+			bool Out : 1;
+			bool Retval : 1;
 		};
 
 		struct Function
 		{
 			unsigned long VtblOffset;
-			bool IsDispatchOnly;
 			MEMBERID MemberId;
-			std::string Name;
+			InternedString Name;
+			InternedString RootName;
 			Type Retval;
 			std::vector<Parameter> ArgList;
-			std::string RootName;
-			bool IsProperty;
-			bool IsPropGet;
-			bool IsPropPut;
-			bool IsPropPutRef;
+			bool IsDispatchOnly : 1;
+			bool IsProperty : 1;
+			bool IsPropGet : 1;
+			bool IsPropPut : 1;
+			bool IsPropPutRef : 1;
 		};
 
 		struct Interface
@@ -132,6 +136,7 @@ namespace Com
 		{
 			std::string Name;
 			std::string OutputName;
+			std::string FileName;
 			GUID Libid;
 			WORD MajorVersion;
 			WORD MinorVersion;
@@ -142,6 +147,8 @@ namespace Com
 			std::vector<Coclass> Coclasses;
 			std::vector<Interface> Interfaces;
 			std::vector<Record> Records;
+			// Holds the names interned while the library was imported; they are freed with the last copy.
+			std::shared_ptr<InternedString::Pool> Strings;
 		};
 
 		struct LoadLibraryResult
@@ -0,0 +1,44 @@
+#include "FileLock.h"
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		FileLock::FileLock(const std::string& fileName)
+		{
+			const DWORD retryDelay = 10;
+			const DWORD timeout = 60000;
+			const DWORD deletePendingTimeout = 100;
+			auto lockFileName = fileName + ".lock";
+			for (DWORD waited = 0; ; waited += retryDelay)
+			{
+				handle = ::CreateFileA(
+					lockFileName.c_str(),
+					GENERIC_READ | GENERIC_WRITE,
+					0,
+					nullptr,
+					OPEN_ALWAYS,
+					FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+					nullptr);
+				if (handle != INVALID_HANDLE_VALUE)
+					return;
+				// Another process holding the lock shows up as a sharing or lock violation. Access denied is
+				// a permissions problem, except for the moment a released lock file is still pending
+				// deletion, so it only gets a few short retries.
+				auto error = ::GetLastError();
+				auto isLocked = error == ERROR_SHARING_VIOLATION || error == ERROR_LOCK_VIOLATION;
+				auto isDeletePending = error == ERROR_ACCESS_DENIED && waited < deletePendingTimeout;
+				if (!(isLocked || isDeletePending) || waited >= timeout)
+					throw std::runtime_error("Unable to lock output file: " + fileName + " (error " + std::to_string(error) + ")");
+				::Sleep(retryDelay);
+			}
+		}
+
+		FileLock::~FileLock()
+		{
+			if (handle != INVALID_HANDLE_VALUE)
+				::CloseHandle(handle);
+		}
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <windows.h>
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class FileLock
+		{
+		private:
+			HANDLE handle = INVALID_HANDLE_VALUE;
+
+		public:
+			FileLock(const std::string& fileName);
+			FileLock(const FileLock& rhs) = delete;
+			~FileLock();
+
+			FileLock& operator=(const FileLock& rhs) = delete;
+		};
+	}
+}
@@ -0,0 +1,255 @@
+#include "FormatterBenchmark.h"
+#include "LibrarySynthesizer.h"
+#include "LibraryFormatter.h"
+#include "InterfaceFormatter.h"
+#include "CoclassFormatter.h"
+#include "FragmentCache.h"
+#include "RecordFormatter.h"
+#include "EnumFormatter.h"
+#include "FunctionFormatter.h"
+#include "ParameterFormatter.h"
+#include "TypeFormatter.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			class CountingBuffer : public std::streambuf
+			{
+			private:
+				std::size_t count = 0;
+
+			public:
+				std::size_t GetCount() const
+				{
+					return count;
+				}
+
+			protected:
+				int overflow(int character) override
+				{
+					++count;
+					return character;
+				}
+
+				std::streamsize xsputn(const char*, std::streamsize size) override
+				{
+					count += static_cast<std::size_t>(size);
+					return size;
+				}
+			};
+
+			struct Mode
+			{
+				const char* Name;
+				const char* Unit;
+				std::size_t Units;
+				std::function<void(std::ostream&)> Write;
+			};
+
+			std::size_t CountFunctions(const Library& library)
+			{
+				std::size_t count = 0;
+				for (auto& iface : library.Interfaces)
+					count += iface.Functions.size();
+				return count;
+			}
+
+			std::size_t CountCoclassFunctions(const Library& library)
+			{
+				std::size_t count = 0;
+				for (auto& coclass : library.Coclasses)
+					for (auto& iface : coclass.Interfaces)
+						count += iface.Functions.size();
+				return count;
+			}
+
+			Mode ForEachInterface(const char* name, const Library& library, InterfaceFormat format)
+			{
+				return{ name, "function", CountFunctions(library), [&library, format](std::ostream& out)
+				{
+					for (auto& iface : library.Interfaces)
+						out << Format(iface, format, "", library.Name);
+				} };
+			}
+
+			Mode ForEachFunction(const char* name, const Library& library, FunctionFormat format)
+			{
+				return{ name, "function", CountFunctions(library), [&library, format](std::ostream& out)
+				{
+					for (auto& iface : library.Interfaces)
+						for (auto& function : iface.Functions)
+							out << Format(function, format, "", iface.Name);
+				} };
+			}
+
+			Mode ForEachParameter(const char* name, const Library& library, ParameterFormat format)
+			{
+				return{ name, "function", CountFunctions(library), [&library, format](std::ostream& out)
+				{
+					for (auto& iface : library.Interfaces)
+						for (auto& function : iface.Functions)
+							for (auto& parameter : function.ArgList)
+								out << Format(parameter, format);
+				} };
+			}
+
+			Mode ForEachType(const char* name, const Library& library, TypeFormat format)
+			{
+				return{ name, "function", CountFunctions(library), [&library, format](std::ostream& out)
+				{
+					for (auto& iface : library.Interfaces)
+						for (auto& function : iface.Functions)
+							for (auto& parameter : function.ArgList)
+								out << Format(parameter.Type, format);
+				} };
+			}
+
+			Mode ForEachCoclass(const char* name, const Library& library, CoclassFormat format)
+			{
+				return{ name, "function", CountCoclassFunctions(library), [&library, format](std::ostream& out)
+				{
+					for (auto& coclass : library.Coclasses)
+						out << Format(coclass, format, library.Name, library.OutputName, &library.Interfaces);
+				} };
+			}
+
+			Mode ForEachCachedCoclass(const char* name, const Library& library, CoclassFormat format)
+			{
+				return{ name, "function", CountCoclassFunctions(library), [&library, format](std::ostream& out)
+				{
+					FragmentCache fragments;
+					for (auto& coclass : library.Coclasses)
+						out << Format(coclass, format, library.Name, library.OutputName, &library.Interfaces, &fragments);
+				} };
+			}
+
+			std::vector<Mode> CreateModes(const Library& library)
+			{
+				return
+				{
+					{ "Library::AsImport", "function", CountFunctions(library), [&library](std::ostream& out)
+					{
+						out << Format(library, LibraryFormat::AsImport);
+					} },
+					{ "Library::AsImport(implement)", "function", CountFunctions(library), [&library](std::ostream& out)
+					{
+						GeneratorOptions options;
+						options.Implement = true;
+						out << Format(library, LibraryFormat::AsImport, options);
+					} },
+					{ "Library::AsImport(bstr-wrappers)", "function", CountFunctions(library), [&library](std::ostream& out)
+					{
+						GeneratorOptions options;
+						options.BstrWrappers = true;
+						out << Format(library, LibraryFormat::AsImport, options);
+					} },
+					{ "Library::AsImport(safearray-views)", "function", CountFunctions(library), [&library](std::ostream& out)
+					{
+						GeneratorOptions options;
+						options.SafeArrayViews = true;
+						out << Format(library, LibraryFormat::AsImport, options);
+					} },
+					{ "Library::AsImport(hresult-wrappers)", "function", CountFunctions(library), [&library](std::ostream& out)
+					{
+						GeneratorOptions options;
+						options.HresultWrappers = true;
+						out << Format(library, LibraryFormat::AsImport, options);
+					} },
+					ForEachInterface("Interface::AsForwardDeclaration", library, InterfaceFormat::AsForwardDeclaration),
+					ForEachInterface("Interface::AsWrapperForwardDeclaration", library, InterfaceFormat::AsWrapperForwardDeclaration),
+					ForEachInterface("Interface::AsNative", library, InterfaceFormat::AsNative),
+					ForEachInterface("Interface::AsResolveNameConflict", library, InterfaceFormat::AsResolveNameConflict),
+					ForEachInterface("Interface::AsWrapper", library, InterfaceFormat::AsWrapper),
+					ForEachInterface("Interface::AsWrapperFunctions", library, InterfaceFormat::AsWrapperFunctions),
+					ForEachInterface("Interface::AsRawFunctions", library, InterfaceFormat::AsRawFunctions),
+					ForEachInterface("Interface::AsTypeInfoSpecialization", library, InterfaceFormat::AsTypeInfoSpecialization),
+					ForEachFunction("Function::AsAbstract", library, FunctionFormat::AsAbstract),
+					ForEachFunction("Function::AsWrapper", library, FunctionFormat::AsWrapper),
+					ForEachFunction("Function::AsWrapperImplementation", library, FunctionFormat::AsWrapperImplementation),
+					ForEachFunction("Function::AsWrapperDispatch", library, FunctionFormat::AsWrapperDispatch),
+					ForEachFunction("Function::AsRawImplementation", library, FunctionFormat::AsRawImplementation),
+					ForEachParameter("Parameter::AsNative", library, ParameterFormat::AsNative),
+					ForEachParameter("Parameter::AsWrapper", library, ParameterFormat::AsWrapper),
+					ForEachParameter("Parameter::AsWrapperArgument", library, ParameterFormat::AsWrapperArgument),
+					ForEachType("Type::AsNative", library, TypeFormat::AsNative),
+					ForEachType("Type::AsWrapper", library, TypeFormat::AsWrapper),
+					ForEachType("Type::AsInitializer", library, TypeFormat::AsInitializer),
+					ForEachCoclass("Coclass::AsBase", library, CoclassFormat::AsBase),
+					ForEachCoclass("Coclass::AsObjectHeader", library, CoclassFormat::AsObjectHeader),
+					ForEachCoclass("Coclass::AsObjectSource", library, CoclassFormat::AsObjectSource),
+					ForEachCachedCoclass("Coclass::AsBase(cached)", library, CoclassFormat::AsBase),
+					ForEachCachedCoclass("Coclass::AsObjectHeader(cached)", library, CoclassFormat::AsObjectHeader),
+					ForEachCachedCoclass("Coclass::AsObjectSource(cached)", library, CoclassFormat::AsObjectSource),
+					{ "Record", "record", library.Records.size(), [&library](std::ostream& out)
+					{
+						for (auto& record : library.Records)
+							out << Format(record);
+					} },
+					{ "Enum", "enum", library.Enums.size(), [&library](std::ostream& out)
+					{
+						for (auto& enumeration : library.Enums)
+							out << Format(enumeration);
+					} }
+				};
+			}
+		}
+
+		void FormatterBenchmark::Run(const BenchmarkSettings& settings, std::ostream& out)
+		{
+			auto names = LibrarySynthesizer::SettingNames;
+			names.push_back("iterations");
+			names.push_back("mode");
+			settings.CheckNames(names);
+
+			LibrarySynthesizer synthesizer{ settings };
+			auto iterations = std::max(1ul, settings.GetNumber("iterations", 5));
+			auto filter = settings.GetString("mode", "");
+			auto library = synthesizer.Synthesize();
+
+			out << "{" << std::endl
+				<< "  \"benchmark\": \"formatters\"," << std::endl;
+			synthesizer.WriteSettings(out);
+			out << "  \"iterations\": " << iterations << "," << std::endl
+				<< "  \"modes\": [";
+			auto first = true;
+			for (auto& mode : CreateModes(library))
+			{
+				if (std::string{ mode.Name }.find(filter) == std::string::npos)
+					continue;
+
+				auto best = std::numeric_limits<double>::max();
+				std::size_t bytes = 0;
+				for (auto iteration = 0ul; iteration < iterations; ++iteration)
+				{
+					CountingBuffer buffer;
+					std::ostream stream{ &buffer };
+					auto start = std::chrono::steady_clock::now();
+					mode.Write(stream);
+					auto finish = std::chrono::steady_clock::now();
+					best = std::min(best, std::chrono::duration<double>(finish - start).count());
+					bytes = buffer.GetCount();
+				}
+
+				out << (first ? "" : ",") << std::endl
+					<< "    { \"mode\": \"" << mode.Name << "\""
+					<< ", \"unit\": \"" << mode.Unit << "\""
+					<< ", \"units\": " << mode.Units
+					<< ", \"bytes\": " << bytes
+					<< ", \"seconds\": " << best
+					<< ", \"ns_per_unit\": " << (mode.Units > 0 ? best * 1e9 / mode.Units : 0)
+					<< ", \"bytes_per_second\": " << (best > 0 ? bytes / best : 0) << " }";
+				first = false;
+			}
+			out << std::endl
+				<< "  ]" << std::endl
+				<< "}" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#include "FragmentCache.h"
+#include "AllocationTracker.h"
+#include <cstring>
+#include <sstream>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			// Stands in for the scope while rendering; it cannot occur in an identifier or literal we emit.
+			const char scopePlaceholder = '\x01';
+		}
+
+		void FragmentCache::Write(
+			std::ostream& out,
+			const Interface& iface,
+			InterfaceFormat format,
+			const std::string& prefix,
+			const std::string& scope)
+		{
+			auto& pieces = GetFragment(iface, format, prefix);
+			for (std::size_t index = 0; index < pieces.size(); ++index)
+			{
+				if (index > 0)
+					out << scope;
+				out << pieces[index];
+			}
+		}
+
+		bool FragmentCache::Key::operator<(const Key& rhs) const
+		{
+			auto order = std::memcmp(&Iid, &rhs.Iid, sizeof(GUID));
+			if (order != 0)
+				return order < 0;
+			if (IsConflicting != rhs.IsConflicting)
+				return !IsConflicting;
+			if (Format != rhs.Format)
+				return Format < rhs.Format;
+			return Prefix < rhs.Prefix;
+		}
+
+		const std::vector<std::string>& FragmentCache::GetFragment(const Interface& iface, InterfaceFormat format, const std::string& prefix)
+		{
+			// The same interface renders differently when a coclass has to resolve its name conflicts.
+			Key key{ iface.Iid, iface.IsConflicting, format, prefix };
+			auto found = fragments.find(key);
+			if (found != fragments.end())
+				return found->second;
+
+			COM_IMPORT_ALLOCATION_SITE("FragmentCache::GetFragment");
+			std::ostringstream rendered;
+			rendered << Format(iface, format, prefix, std::string(1, scopePlaceholder));
+			auto text = rendered.str();
+			std::vector<std::string> pieces;
+			std::size_t start = 0;
+			for (auto end = text.find(scopePlaceholder); end != std::string::npos; end = text.find(scopePlaceholder, start))
+			{
+				pieces.push_back(text.substr(start, end - start));
+				start = end + 1;
+			}
+			pieces.push_back(text.substr(start));
+			return fragments.emplace(std::move(key), std::move(pieces)).first->second;
+		}
+	}
+}
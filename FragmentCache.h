@@ -0,0 +1,41 @@
+#pragma once
+#include "DataTypes.h"
+#include "InterfaceFormatter.h"
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class FragmentCache
+		{
+		private:
+			struct Key
+			{
+				GUID Iid;
+				bool IsConflicting;
+				InterfaceFormat Format;
+				std::string Prefix;
+
+				bool operator<(const Key& rhs) const;
+			};
+
+			// Each fragment is split at the scope, which is the only part that differs between coclasses.
+			std::map<Key, std::vector<std::string>> fragments;
+
+		public:
+			void Write(
+				std::ostream& out,
+				const Interface& iface,
+				InterfaceFormat format,
+				const std::string& prefix,
+				const std::string& scope);
+
+		private:
+			const std::vector<std::string>& GetFragment(const Interface& iface, InterfaceFormat format, const std::string& prefix);
+		};
+	}
+}
@@ -2,6 +2,8 @@
 #include "TypeDescription.h"
 #include "ElementDescription.h"
 #include "ArgumentNames.h"
+#include "Statistics.h"
+#include "Utf8.h"
 
 namespace Com
 {
@@ -14,22 +16,33 @@ namespace Com
 			: libraryName(libraryName),
 			typeInfo(typeInfo)
 		{
+			COM_IMPORT_COUNT_CALL("GetFuncDesc");
 			auto hr = typeInfo->GetFuncDesc(index, &description);
 			CheckError(hr, __FUNCTION__, "GetFuncDesc");
+			try
+			{
+				LoadNames();
+			}
+			catch (...)
+			{
+				COM_IMPORT_COUNT_CALL("ReleaseFuncDesc");
+				typeInfo->ReleaseFuncDesc(description);
+				throw;
+			}
 		}
 
 		FunctionDescription::~FunctionDescription()
 		{
 			if (description != nullptr)
+			{
+				COM_IMPORT_COUNT_CALL("ReleaseFuncDesc");
 				typeInfo->ReleaseFuncDesc(description);
+			}
 		}
 
-		std::string FunctionDescription::GetRootName() const
+		const std::string& FunctionDescription::GetRootName() const
 		{
-			std::string name;
-			auto hr = typeInfo->GetDocumentation(description->memid, Get(name), nullptr, nullptr, nullptr);
-			CheckError(hr, __FUNCTION__, "GetDocumentation");
-			return name;
+			return rootName;
 		}
 
 		bool FunctionDescription::IsProperty() const
@@ -52,15 +65,9 @@ namespace Com
 			return description->invkind == INVOKE_PROPERTYPUTREF;
 		}
 
-		std::string FunctionDescription::GetName() const
+		const std::string& FunctionDescription::GetName() const
 		{
-			if (IsPropGet())
-				return "get_" + GetRootName();
-			if (IsPropPut())
-				return "put_" + GetRootName();
-			if (IsPropPutRef())
-				return "putref_" + GetRootName();
-			return GetRootName();
+			return name;
 		}
 
 		bool FunctionDescription::IsDispatchOnly() const
@@ -78,10 +85,8 @@ namespace Com
 		std::vector<Parameter> FunctionDescription::GetParameters() const
 		{
 			std::vector<Parameter> result;
-			UINT argumentCount = description->cParams;
-			ArgumentNames names{ typeInfo, description->memid, argumentCount };
-			for (auto index = 0u; index < argumentCount; ++index)
-				result.push_back(CreateParameter(names[index], description->lprgelemdescParam[index]));
+			for (auto index = 0u; index < parameterNames.size(); ++index)
+				result.push_back(CreateParameter(parameterNames[index], description->lprgelemdescParam[index]));
 			return result;
 		}
 
@@ -95,12 +100,12 @@ namespace Com
 			Function value
 			{
 				static_cast<unsigned long>(description->oVft),
-				IsDispatchOnly(),
 				description->memid,
 				GetName(),
+				GetRootName(),
 				GetRetval(),
 				GetParameters(),
-				GetRootName(),
+				IsDispatchOnly(),
 				IsProperty(),
 				IsPropGet(),
 				IsPropPut(),
@@ -110,10 +115,38 @@ namespace Com
 				return value;
 			if (value.Retval.TypeEnum != TypeEnum::Void)
 				value.ArgList.push_back(ConvertResultToArgument(value.Retval));
-			value.Retval = { 0, TypeEnum::Hresult, "", false, 0 };
+			value.Retval = { 0, TypeEnum::Hresult, "", false, 0, TypeEnum::Empty };
 			return value;
 		}
 
+		void FunctionDescription::LoadNames()
+		{
+			COM_IMPORT_ALLOCATION_SITE("FunctionDescription::LoadNames");
+			UINT argumentCount = description->cParams;
+			ArgumentNames names{ typeInfo, description->memid, argumentCount };
+			rootName = names.HasMemberName() ? names.GetMemberName() : QueryRootName();
+			if (IsPropGet())
+				name = "get_" + rootName;
+			else if (IsPropPut())
+				name = "put_" + rootName;
+			else if (IsPropPutRef())
+				name = "putref_" + rootName;
+			else
+				name = rootName;
+			parameterNames.reserve(argumentCount);
+			for (auto index = 0u; index < argumentCount; ++index)
+				parameterNames.push_back(names[index]);
+		}
+
+		std::string FunctionDescription::QueryRootName() const
+		{
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			auto hr = typeInfo->GetDocumentation(description->memid, text, nullptr, nullptr, nullptr);
+			CheckError(hr, __FUNCTION__, "GetDocumentation");
+			return text.ToString();
+		}
+
 		Parameter FunctionDescription::ConvertResultToArgument(const Type& type)
 		{
 			Parameter argument{ "retval", type, false, true, true };
@@ -12,6 +12,9 @@ namespace Com
 			std::string libraryName;
 			Pointer<ITypeInfo2> typeInfo;
 			FUNCDESC* description = nullptr;
+			std::string rootName;
+			std::string name;
+			std::vector<std::string> parameterNames;
 
 		public:
 			FunctionDescription(const std::string& libraryName, Pointer<ITypeInfo2> typeInfo, UINT index);
@@ -20,12 +23,12 @@ namespace Com
 
 			FunctionDescription& operator=(const FunctionDescription& rhs) = delete;
 
-			std::string GetRootName() const;
+			const std::string& GetRootName() const;
 			bool IsProperty() const;
 			bool IsPropGet() const;
 			bool IsPropPut() const;
 			bool IsPropPutRef() const;
-			std::string GetName() const;
+			const std::string& GetName() const;
 			bool IsDispatchOnly() const;
 			Type GetRetval() const;
 			std::vector<Parameter> GetParameters() const;
@@ -33,6 +36,8 @@ namespace Com
 			Function ToFunction(bool supportsDispatch) const;
 
 		private:
+			void LoadNames();
+			std::string QueryRootName() const;
 			static Parameter ConvertResultToArgument(const Type& type);
 		};
 	}
@@ -1,6 +1,7 @@
 #include "FunctionFormatter.h"
 #include "TypeFormatter.h"
 #include "ParameterFormatter.h"
+#include "HexFormatter.h"
 
 namespace Com
 {
@@ -10,8 +11,9 @@ namespace Com
 			const Function& value,
 			FunctionFormat format,
 			const std::string& prefix,
-			const std::string& scope)
-			: value(value), format(format), prefix(prefix), scope(scope)
+			const std::string& scope,
+			const GeneratorOptions& options)
+			: value(value), format(format), prefix(prefix), scope(scope), options(options)
 		{
 		}
 
@@ -34,6 +36,27 @@ namespace Com
 			case FunctionFormat::AsWrapperDispatch:
 				WriteAsWrapperDispatch(out);
 				break;
+			case FunctionFormat::AsViewWrapper:
+				WriteAsViewWrapper(out);
+				break;
+			case FunctionFormat::AsViewWrapperImplementation:
+				WriteAsViewWrapperImplementation(out);
+				break;
+			case FunctionFormat::AsTryWrapper:
+				WriteAsTryWrapper(out);
+				break;
+			case FunctionFormat::AsTryWrapperImplementation:
+				WriteAsTryWrapperImplementation(out);
+				break;
+			case FunctionFormat::AsCallTag:
+				WriteAsCallTag(out);
+				break;
+			case FunctionFormat::AsInvokeCase:
+				WriteAsInvokeCase(out);
+				break;
+			case FunctionFormat::AsInvokeBranch:
+				WriteAsInvokeBranch(out);
+				break;
 			case FunctionFormat::AsRawImplementation:
 				WriteAsRawImplementation(out);
 				break;
@@ -92,13 +115,13 @@ namespace Com
 
 		void FunctionFormatter::WriteAsWrapperImplementation(std::ostream& out) const
 		{
-			out << "	template <typename Interface>" << std::endl
+			out << "	template <typename Interface, typename Policy>" << std::endl
 				<< "	inline ";
 			if (HasRetval())
 				out << Format(GetRetval().Type, TypeFormat::AsWrapper);
 			else
 				out << "void";
-			out << " " << scope << "PtrT<Interface>::" << value.Name << "(";
+			out << " " << scope << "PtrT<Interface, Policy>::" << value.Name << "(";
 			WriteArguments(out, ParameterFormat::AsWrapper, true);
 			out << ")" << std::endl
 				<< "	{" << std::endl;
@@ -110,6 +133,7 @@ namespace Com
 				out << Format(GetRetval().Type, TypeFormat::AsInitializer);
 				out << ";" << std::endl;
 			}
+			WriteBeforeCall(out, "		");
 			out << "		";
 			if (value.Retval.TypeEnum == TypeEnum::Hresult)
 				out << "auto hr = ";
@@ -118,6 +142,7 @@ namespace Com
 			out << value.Name << "(";
 			WriteArguments(out, ParameterFormat::AsWrapperArgument, false);
 			out << ");" << std::endl;
+			WriteAfterCall(out, "		");
 			if (value.Retval.TypeEnum == TypeEnum::Hresult)
 				out << "		Com::CheckError(hr, __FUNCTION__, \"\");" << std::endl;
 			if (HasRetval())
@@ -127,7 +152,178 @@ namespace Com
 
 		void FunctionFormatter::WriteAsWrapperDispatch(std::ostream& out) const
 		{
-			//TODO: dispatch-only wrapper implementation
+			auto count = value.ArgList.size() - (HasRetval() ? 1 : 0);
+			out << "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline ";
+			if (HasRetval())
+				out << Format(GetRetval().Type, TypeFormat::AsWrapper);
+			else
+				out << "void";
+			out << " " << scope << "PtrT<Interface, Policy>::" << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsWrapper, true);
+			out << ")" << std::endl
+				<< "	{" << std::endl
+				<< "		Com::Import::Dispatch::Arguments<" << count << "> invokeArguments;" << std::endl;
+			for (auto index = 0u; index < count; ++index)
+				if (value.ArgList[index].Out)
+					out << "		Com::Import::Dispatch::Reference invokeReference" << index << ";" << std::endl;
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto& argument = value.ArgList[index];
+				if (argument.Out)
+					out << "		invokeReference" << index << ".Bind(invokeArguments[" << index << "], "
+						<< argument.Name << ", " << (argument.In ? "true" : "false") << ");" << std::endl;
+				else
+					out << "		Com::Import::Dispatch::Put(invokeArguments[" << index << "], " << argument.Name << ");" << std::endl;
+			}
+			if (HasRetval())
+				out << "		Com::Import::Dispatch::Value invokeResult;" << std::endl;
+			WriteBeforeCall(out, "		");
+			out << "		auto hr = Com::Import::Dispatch::Invoke(p, ";
+			WriteMemberId(out);
+			out << ", " << GetInvokeFlags()
+				<< ", invokeArguments.Get(), " << count << ", " << (HasRetval() ? "invokeResult.Get()" : "nullptr") << ");" << std::endl;
+			WriteAfterCall(out, "		");
+			out << "		Com::CheckError(hr, __FUNCTION__, \"Invoke\");" << std::endl;
+			for (auto index = 0u; index < count; ++index)
+				if (value.ArgList[index].Out)
+					out << "		invokeReference" << index << ".Read(" << value.ArgList[index].Name << ");" << std::endl;
+			if (HasRetval())
+			{
+				out << "		" << Format(GetRetval().Type, TypeFormat::AsWrapper)
+					<< " retval" << Format(GetRetval().Type, TypeFormat::AsInitializer) << ";" << std::endl
+					<< "		Com::Import::Dispatch::Get(*invokeResult, retval);" << std::endl
+					<< "		return retval;" << std::endl;
+			}
+			out << "	}" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsViewWrapper(std::ostream& out) const
+		{
+			if (!HasViewArguments() && !HasViewRetval())
+				return;
+			out << "		";
+			WriteViewWrapperReturnType(out);
+			out << " " << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapper, ReturnsViewWrapperValue());
+			out << ");" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsViewWrapperImplementation(std::ostream& out) const
+		{
+			if (!HasViewArguments() && !HasViewRetval())
+				return;
+			out << "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline ";
+			WriteViewWrapperReturnType(out);
+			out << " " << scope << "PtrT<Interface, Policy>::" << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapper, ReturnsViewWrapperValue());
+			out << ")" << std::endl
+				<< "	{" << std::endl;
+			if (ReturnsViewWrapperValue())
+			{
+				out << "		";
+				WriteViewWrapperReturnType(out);
+				out << " retval";
+				if (!HasViewRetval())
+					out << Format(GetRetval().Type, TypeFormat::AsInitializer);
+				out << ";" << std::endl;
+			}
+			WriteBeforeCall(out, "		");
+			out << "		";
+			if (value.Retval.TypeEnum == TypeEnum::Hresult)
+				out << "auto hr = ";
+			out << "p->" << prefix << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapperArgument, false);
+			out << ");" << std::endl;
+			WriteAfterCall(out, "		");
+			if (value.Retval.TypeEnum == TypeEnum::Hresult)
+				out << "		Com::CheckError(hr, __FUNCTION__, \"\");" << std::endl;
+			if (ReturnsViewWrapperValue())
+				out << "		return retval;" << std::endl;
+			out << "	}" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsTryWrapper(std::ostream& out) const
+		{
+			if (value.Retval.TypeEnum != TypeEnum::Hresult)
+				return;
+			out << "		HRESULT Try" << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapper, false);
+			out << ") noexcept;" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsTryWrapperImplementation(std::ostream& out) const
+		{
+			if (value.Retval.TypeEnum != TypeEnum::Hresult)
+				return;
+			// Only argument conversion can throw here; a failed call is returned as is.
+			out << "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline HRESULT " << scope << "PtrT<Interface, Policy>::Try" << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapper, false);
+			out << ") noexcept" << std::endl
+				<< "	{" << std::endl
+				<< "		try" << std::endl
+				<< "		{" << std::endl;
+			WriteBeforeCall(out, "			");
+			out << "			auto hr = p->" << prefix << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsViewWrapperArgument, false);
+			out << ");" << std::endl;
+			WriteAfterCall(out, "			");
+			out << "			return hr;" << std::endl
+				<< "		}" << std::endl
+				<< "		catch (const std::bad_alloc&)" << std::endl
+				<< "		{" << std::endl
+				<< "			return E_OUTOFMEMORY;" << std::endl
+				<< "		}" << std::endl
+				<< "		catch (...)" << std::endl
+				<< "		{" << std::endl
+				<< "			return E_FAIL;" << std::endl
+				<< "		}" << std::endl
+				<< "	}" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsCallTag(std::ostream& out) const
+		{
+			out << "			struct " << value.Name << "Call { "
+				<< "static constexpr const char* GetInterfaceName() { return \"" << scope << "\"; } "
+				<< "static constexpr const char* GetMethodName() { return \"" << value.Name << "\"; } };" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsInvokeCase(std::ostream& out) const
+		{
+			out << "				case ";
+			WriteMemberId(out);
+			out << ":" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAsInvokeBranch(std::ostream& out) const
+		{
+			auto count = value.ArgList.size() - (HasRetval() ? 1 : 0);
+			out << "					if ((invokeFlags & " << GetInvokeFlags() << ") != 0 && invokeParameters->cArgs == " << count << ")" << std::endl
+				<< "						return Com::RunAction([&]()" << std::endl
+				<< "						{" << std::endl
+				<< "							Com::Import::Dispatch::Invocation invokeArguments{ invokeParameters };" << std::endl;
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto& argument = value.ArgList[index];
+				out << "							" << Format(argument.Type, TypeFormat::AsWrapper) << " " << argument.Name
+					<< Format(argument.Type, TypeFormat::AsInitializer) << ";" << std::endl;
+				if (argument.In)
+					out << "							invokeArguments.Read(" << index << ", " << argument.Name << ");" << std::endl;
+			}
+			out << "							";
+			if (HasRetval())
+				out << "auto invokeReturn = ";
+			out << prefix << value.Name << "(";
+			WriteArguments(out, ParameterFormat::AsName, true);
+			out << ");" << std::endl;
+			for (auto index = 0u; index < count; ++index)
+				if (value.ArgList[index].Out)
+					out << "							invokeArguments.Write(" << index << ", " << value.ArgList[index].Name << ");" << std::endl;
+			if (HasRetval())
+				out << "							invokeArguments.Return(invokeResult, invokeReturn);" << std::endl;
+			out << "						});" << std::endl;
 		}
 
 		void FunctionFormatter::WriteAsRawImplementation(std::ostream& out) const
@@ -195,6 +391,65 @@ namespace Com
 			return value.ArgList.back();
 		}
 
+		bool FunctionFormatter::HasViewArguments() const
+		{
+			for (auto& argument : value.ArgList)
+				if (!argument.Retval && ParameterFormatter::IsView(argument, options))
+					return true;
+			return false;
+		}
+
+		bool FunctionFormatter::HasViewRetval() const
+		{
+			return HasRetval() && ParameterFormatter::IsView(GetRetval(), options);
+		}
+
+		bool FunctionFormatter::ReturnsViewWrapperValue() const
+		{
+			// A view retval alone would leave the overload differing only by return type, so it becomes an out reference.
+			return HasRetval() && (HasViewArguments() || !HasViewRetval());
+		}
+
+		void FunctionFormatter::WriteViewWrapperReturnType(std::ostream& out) const
+		{
+			if (!ReturnsViewWrapperValue())
+				out << "void";
+			else if (HasViewRetval())
+				out << Format(GetRetval().Type, TypeFormat::AsView);
+			else
+				out << Format(GetRetval().Type, TypeFormat::AsWrapper);
+		}
+
+		const char* FunctionFormatter::GetInvokeFlags() const
+		{
+			if (value.IsPropGet)
+				return "DISPATCH_PROPERTYGET";
+			if (value.IsPropPut)
+				return "DISPATCH_PROPERTYPUT";
+			if (value.IsPropPutRef)
+				return "DISPATCH_PROPERTYPUTREF";
+			return "DISPATCH_METHOD";
+		}
+
+		void FunctionFormatter::WriteMemberId(std::ostream& out) const
+		{
+			if (value.MemberId >= 0)
+				out << Hex(static_cast<unsigned int>(value.MemberId));
+			else
+				out << value.MemberId;
+		}
+
+		void FunctionFormatter::WriteBeforeCall(std::ostream& out, const char* indent) const
+		{
+			out << indent << "Policy::template Before<CallTags::" << scope << "::" << value.Name << "Call>();" << std::endl;
+		}
+
+		void FunctionFormatter::WriteAfterCall(std::ostream& out, const char* indent) const
+		{
+			out << indent << "Policy::template After<CallTags::" << scope << "::" << value.Name << "Call>("
+				<< (value.Retval.TypeEnum == TypeEnum::Hresult || format == FunctionFormat::AsWrapperDispatch ? "hr" : "S_OK") << ");" << std::endl;
+		}
+
 		void FunctionFormatter::WriteArguments(std::ostream& out, ParameterFormat format, bool skipReturnValue) const
 		{
 			auto first = true;
@@ -205,7 +460,7 @@ namespace Com
 				if (!first)
 					out << ", ";
 				first = false;
-				out << Format(argument, format);
+				out << Format(argument, format, options);
 			}
 		}
 
@@ -213,9 +468,10 @@ namespace Com
 			const Function& value,
 			FunctionFormat format,
 			const std::string& prefix,
-			const std::string& scope)
+			const std::string& scope,
+			const GeneratorOptions& options)
 		{
-			return{ value, format, prefix, scope };
+			return{ value, format, prefix, scope, options };
 		}
 	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "DataTypes.h"
+#include "Options.h"
 #include <iostream>
 #include "ParameterFormatter.h"
 
@@ -14,6 +15,13 @@ namespace Com
 			AsWrapper,
 			AsWrapperImplementation,
 			AsWrapperDispatch,
+			AsViewWrapper,
+			AsViewWrapperImplementation,
+			AsTryWrapper,
+			AsTryWrapperImplementation,
+			AsCallTag,
+			AsInvokeCase,
+			AsInvokeBranch,
 			AsRawImplementation,
 			AsCoclassAbstract,
 			AsCoclassPrototype,
@@ -27,13 +35,15 @@ namespace Com
 			FunctionFormat format;
 			std::string prefix;
 			std::string scope;
+			GeneratorOptions options;
 
 		public:
 			FunctionFormatter(
 				const Function& value,
 				FunctionFormat format,
 				const std::string& prefix,
-				const std::string& scope);
+				const std::string& scope,
+				const GeneratorOptions& options);
 
 			std::ostream& Write(std::ostream& out) const;
 			friend std::ostream& operator<<(std::ostream& out, const FunctionFormatter& value);
@@ -44,6 +54,13 @@ namespace Com
 			void WriteAsWrapper(std::ostream& out) const;
 			void WriteAsWrapperImplementation(std::ostream& out) const;
 			void WriteAsWrapperDispatch(std::ostream& out) const;
+			void WriteAsViewWrapper(std::ostream& out) const;
+			void WriteAsViewWrapperImplementation(std::ostream& out) const;
+			void WriteAsTryWrapper(std::ostream& out) const;
+			void WriteAsTryWrapperImplementation(std::ostream& out) const;
+			void WriteAsCallTag(std::ostream& out) const;
+			void WriteAsInvokeCase(std::ostream& out) const;
+			void WriteAsInvokeBranch(std::ostream& out) const;
 			void WriteAsRawImplementation(std::ostream& out) const;
 			void WriteAsCoclassAbstract(std::ostream& out) const;
 			void WriteAsCoclassPrototype(std::ostream& out) const;
@@ -51,6 +68,14 @@ namespace Com
 
 			bool HasRetval() const;
 			const Parameter& GetRetval() const;
+			bool HasViewArguments() const;
+			bool HasViewRetval() const;
+			bool ReturnsViewWrapperValue() const;
+			void WriteViewWrapperReturnType(std::ostream& out) const;
+			const char* GetInvokeFlags() const;
+			void WriteMemberId(std::ostream& out) const;
+			void WriteBeforeCall(std::ostream& out, const char* indent) const;
+			void WriteAfterCall(std::ostream& out, const char* indent) const;
 			void WriteArguments(std::ostream& out, ParameterFormat format, bool skipReturnValue) const;
 		};
 
@@ -58,6 +83,7 @@ namespace Com
 			const Function& value,
 			FunctionFormat format,
 			const std::string& prefix = "",
-			const std::string& scope = "");
+			const std::string& scope = "",
+			const GeneratorOptions& options = GeneratorOptions{});
 	}
 }
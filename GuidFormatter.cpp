@@ -1,6 +1,6 @@
 #include "GuidFormatter.h"
-#include <locale>
-#include <codecvt>
+#include "AllocationTracker.h"
+#include "Utf8.h"
 #include <stdexcept>
 #include "HexFormatter.h"
 
@@ -37,12 +37,15 @@ namespace Com
 
 		void GuidFormatter::WriteAsString(std::ostream& out) const
 		{
+			COM_IMPORT_ALLOCATION_SITE("GuidFormatter::WriteAsString");
 			const auto bufferSize = 39;
 			wchar_t buffer[bufferSize];
 			auto result = ::StringFromGUID2(value, buffer, bufferSize);
 			if (result != bufferSize)
 				throw std::runtime_error("Error formatting GUID");
-			out << std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(buffer).substr(1, 36);
+			char text[bufferSize * 4];
+			Utf8::Convert(buffer, bufferSize - 1, text);
+			out.write(text + 1, 36);
 		}
 
 		void GuidFormatter::WriteAsAttribute(std::ostream& out) const
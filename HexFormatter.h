@@ -22,7 +22,7 @@ namespace Com
 			std::ostream& Write(std::ostream& out) const
 			{
 				static_assert(sizeof(value) <= sizeof(int), "Integer type is too large.");
-				using UnsignedInteger = std::make_unsigned<Integer>::type;
+				using UnsignedInteger = typename std::make_unsigned<Integer>::type;
 				return out << "0x"
 					<< std::setw(sizeof(value) * 2)
 					<< std::setfill('0')
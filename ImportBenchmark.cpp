@@ -0,0 +1,109 @@
+#include "ImportBenchmark.h"
+#include "TraceSynthesizer.h"
+#include "TypeLibraryReplayer.h"
+#include "LibraryLoader.h"
+#include "CodeGenerator.h"
+#include "LowMemoryImport.h"
+#include "ProcessInfo.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			class NullBuffer : public std::streambuf
+			{
+			protected:
+				int overflow(int character) override
+				{
+					return character;
+				}
+			};
+
+			class ConsoleSilencer
+			{
+			private:
+				NullBuffer buffer;
+				std::streambuf* previous;
+
+			public:
+				ConsoleSilencer()
+					: previous(std::cout.rdbuf(&buffer))
+				{
+				}
+
+				~ConsoleSilencer()
+				{
+					std::cout.rdbuf(previous);
+				}
+			};
+		}
+
+		void ImportBenchmark::Run(const BenchmarkSettings& settings, std::ostream& out)
+		{
+			auto names = TraceSynthesizer::SettingNames;
+			names.push_back("iterations");
+			names.push_back("implement");
+			names.push_back("low_memory");
+			settings.CheckNames(names);
+
+			TraceSynthesizer synthesizer{ settings };
+			auto iterations = std::max(1ul, settings.GetNumber("iterations", 1));
+			GeneratorOptions options;
+			options.Implement = settings.GetNumber("implement", 0) != 0;
+			auto lowMemory = settings.GetNumber("low_memory", 0) != 0;
+
+			auto bestLoad = std::numeric_limits<double>::max();
+			auto bestGenerate = std::numeric_limits<double>::max();
+			for (auto iteration = 0ul; iteration < iterations; ++iteration)
+			{
+				TypeLibraryReplayer replayer{ synthesizer.Synthesize() };
+				ConsoleSilencer silencer;
+
+				auto start = std::chrono::steady_clock::now();
+				LoadLibraryResult result;
+				CodeGenerator generator;
+				std::chrono::steady_clock::time_point loaded;
+				if (lowMemory)
+				{
+					// Import headers are written and released during the load, as with --low-memory.
+					LowMemoryImport::Load(TraceSynthesizer::FileName, options, generator, result);
+					loaded = std::chrono::steady_clock::now();
+					generator.GenerateImplementation(result, options);
+				}
+				else
+				{
+					{
+						LibraryLoader loader;
+						result = loader.Load(TraceSynthesizer::FileName);
+					}
+					loaded = std::chrono::steady_clock::now();
+					generator.Generate(result, options);
+				}
+				auto generated = std::chrono::steady_clock::now();
+
+				bestLoad = std::min(bestLoad, std::chrono::duration<double>(loaded - start).count());
+				bestGenerate = std::min(bestGenerate, std::chrono::duration<double>(generated - loaded).count());
+			}
+
+			auto types = synthesizer.GetTypeCount();
+			auto total = bestLoad + bestGenerate;
+			out << "{" << std::endl
+				<< "  \"benchmark\": \"import\"," << std::endl;
+			synthesizer.WriteSettings(out);
+			out << "  \"iterations\": " << iterations << "," << std::endl
+				<< "  \"low_memory\": " << (lowMemory ? 1 : 0) << "," << std::endl
+				<< "  \"types\": " << types << "," << std::endl
+				<< "  \"load_seconds\": " << bestLoad << "," << std::endl
+				<< "  \"generate_seconds\": " << bestGenerate << "," << std::endl
+				<< "  \"types_per_second\": " << (total > 0 ? types / total : 0) << "," << std::endl
+				<< "  \"peak_working_set_bytes\": " << ProcessInfo::GetPeakWorkingSet() << std::endl
+				<< "}" << std::endl;
+		}
+	}
+}
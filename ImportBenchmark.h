@@ -0,0 +1,15 @@
+#pragma once
+#include "BenchmarkSettings.h"
+#include <ostream>
+
+namespace Com
+{
+	namespace Import
+	{
+		class ImportBenchmark
+		{
+		public:
+			static void Run(const BenchmarkSettings& settings, std::ostream& out);
+		};
+	}
+}
@@ -10,8 +10,9 @@ namespace Com
 			const Interface& value,
 			InterfaceFormat format,
 			const std::string& prefix,
-			const std::string& scope)
-			: value(value), format(format), prefix(prefix), scope(scope)
+			const std::string& scope,
+			const GeneratorOptions& options)
+			: value(value), format(format), prefix(prefix), scope(scope), options(options)
 		{
 		}
 
@@ -69,7 +70,7 @@ namespace Com
 
 		void InterfaceFormatter::WriteAsWrapperForwardDeclaration(std::ostream& out) const
 		{
-			out << "	template <typename Interface> class " << value.Name << "PtrT;" << std::endl
+			out << "	template <typename Interface, typename Policy = COM_IMPORT_CALL_POLICY> class " << value.Name << "PtrT;" << std::endl
 				<< "	using " << value.Name << "Ptr = " << value.Name << "PtrT<" << value.Name << ">;" << std::endl;
 		}
 
@@ -120,34 +121,51 @@ namespace Com
 
 		void InterfaceFormatter::WriteAsWrapper(std::ostream& out) const
 		{
-			out << "	template <typename Interface>" << std::endl
+			out << "	namespace CallTags" << std::endl
+				<< "	{" << std::endl
+				<< "		namespace " << value.Name << std::endl
+				<< "		{" << std::endl;
+			for (auto& function : value.Functions)
+				if ((function.VtblOffset == 0 && function.IsDispatchOnly) || (function.VtblOffset >= value.VtblOffset))
+					out << Format(function, FunctionFormat::AsCallTag, "", value.Name);
+			out << "		}" << std::endl
+				<< "	}" << std::endl
+				<< "	template <typename Interface, typename Policy>" << std::endl
 				<< "	class " << value.Name << "PtrT : public " << GetWrapperBase() << std::endl
 				<< "	{" << std::endl
 				<< "	public:" << std::endl
 				<< "		" << value.Name << "PtrT(Interface* value = nullptr);" << std::endl
-				<< "		" << value.Name << "PtrT<Interface>& operator=(Interface* value);" << std::endl
+				<< "		" << value.Name << "PtrT<Interface, Policy>& operator=(Interface* value);" << std::endl
 				<< "		operator " << value.Name << "*() const;" << std::endl;
 			for (auto& function : value.Functions)
 				if ((function.VtblOffset == 0 && function.IsDispatchOnly) || (function.VtblOffset >= value.VtblOffset))
 					out << Format(function, FunctionFormat::AsWrapper);
+			if (options.BstrWrappers || options.SafeArrayViews)
+				for (auto& function : value.Functions)
+					if (!function.IsDispatchOnly && function.VtblOffset >= value.VtblOffset)
+						out << Format(function, FunctionFormat::AsViewWrapper, "", "", options);
+			if (options.HresultWrappers)
+				for (auto& function : value.Functions)
+					if (!function.IsDispatchOnly && function.VtblOffset >= value.VtblOffset)
+						out << Format(function, FunctionFormat::AsTryWrapper, "", "", options);
 			out << "	};" << std::endl;
 		}
 
 		void InterfaceFormatter::WriteAsWrapperFunctions(std::ostream& out) const
 		{
-			out << "	template <typename Interface>" << std::endl
-				<< "	inline " << value.Name << "PtrT<Interface>::" << value.Name << "PtrT(Interface* value) : " << GetWrapperBase() << "(value)" << std::endl
+			out << "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline " << value.Name << "PtrT<Interface, Policy>::" << value.Name << "PtrT(Interface* value) : " << GetWrapperBase() << "(value)" << std::endl
 				<< "	{" << std::endl
 				<< "	}" << std::endl
-				<< "	template <typename Interface>" << std::endl
-				<< "	inline " << value.Name << "PtrT<Interface>& " << value.Name << "PtrT<Interface>::operator=(Interface* value)" << std::endl
+				<< "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline " << value.Name << "PtrT<Interface, Policy>& " << value.Name << "PtrT<Interface, Policy>::operator=(Interface* value)" << std::endl
 				<< "	{" << std::endl
 				<< "		using Base = " << GetWrapperBase() << ";" << std::endl
 				<< "		Base::operator=(value);" << std::endl
 				<< "		return *this;" << std::endl
 				<< "	}" << std::endl
-				<< "	template <typename Interface>" << std::endl
-				<< "	inline " << value.Name << "PtrT<Interface>::operator " << value.Name << "*() const" << std::endl
+				<< "	template <typename Interface, typename Policy>" << std::endl
+				<< "	inline " << value.Name << "PtrT<Interface, Policy>::operator " << value.Name << "*() const" << std::endl
 				<< "	{" << std::endl
 				<< "		return p;" << std::endl
 				<< "	}" << std::endl;
@@ -158,6 +176,14 @@ namespace Com
 				else if (function.VtblOffset >= value.VtblOffset)
 					out << Format(function, FunctionFormat::AsWrapperImplementation, prefix, value.Name);
 			}
+			if (options.BstrWrappers || options.SafeArrayViews)
+				for (auto& function : value.Functions)
+					if (!function.IsDispatchOnly && function.VtblOffset >= value.VtblOffset)
+						out << Format(function, FunctionFormat::AsViewWrapperImplementation, prefix, value.Name, options);
+			if (options.HresultWrappers)
+				for (auto& function : value.Functions)
+					if (!function.IsDispatchOnly && function.VtblOffset >= value.VtblOffset)
+						out << Format(function, FunctionFormat::AsTryWrapperImplementation, prefix, value.Name, options);
 		}
 
 		void InterfaceFormatter::WriteAsRawFunctions(std::ostream& out) const
@@ -205,16 +231,17 @@ namespace Com
 		{
 			if (value.Base == "IUnknown" || value.Base == "IDispatch")
 				return "Com::Pointer<Interface>";
-			return value.Base + "PtrT<Interface>";
+			return value.Base + "PtrT<Interface, Policy>";
 		}
 
 		InterfaceFormatter Format(
 			const Interface& value,
 			InterfaceFormat format,
 			const std::string& prefix,
-			const std::string& scope)
+			const std::string& scope,
+			const GeneratorOptions& options)
 		{
-			return{ value, format, prefix, scope };
+			return{ value, format, prefix, scope, options };
 		}
 	}
 }
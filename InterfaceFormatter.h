@@ -1,5 +1,6 @@
 #pragma once
 #include "DataTypes.h"
+#include "Options.h"
 #include <iostream>
 
 namespace Com
@@ -28,13 +29,15 @@ namespace Com
 			InterfaceFormat format;
 			std::string prefix;
 			std::string scope;
+			GeneratorOptions options;
 
 		public:
 			InterfaceFormatter(
 				const Interface& value,
 				InterfaceFormat format,
 				const std::string& prefix,
-				const std::string& scope);
+				const std::string& scope,
+				const GeneratorOptions& options);
 
 			std::ostream& Write(std::ostream& out) const;
 			friend std::ostream& operator<<(std::ostream& out, const InterfaceFormatter& value);
@@ -52,13 +55,14 @@ namespace Com
 			void WriteAsCoclassFunctionImplementations(std::ostream& out) const;
 			void WriteAsTypeInfoSpecialization(std::ostream& out) const;
 
-			std::string InterfaceFormatter::GetWrapperBase() const;
+			std::string GetWrapperBase() const;
 		};
 
 		InterfaceFormatter Format(
 			const Interface& value,
 			InterfaceFormat format,
 			const std::string& prefix = "",
-			const std::string& scope = "");
+			const std::string& scope = "",
+			const GeneratorOptions& options = GeneratorOptions{});
 	}
 }
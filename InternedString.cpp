@@ -0,0 +1,255 @@
+#include "InternedString.h"
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const std::uint32_t chunkBits = 12;
+			const std::uint32_t chunkSize = 1u << chunkBits;
+			const std::uint32_t localBits = 22;
+			const std::uint32_t maximumChunks = 1u << (localBits - chunkBits);
+			const std::uint32_t maximumPools = 1u << (32 - localBits);
+
+			// Strings live in fixed chunks that never move, so readers on other threads can index them
+			// without taking the lock that guards interning.
+			class StringTable
+			{
+			private:
+				std::mutex mutex;
+				std::unordered_map<std::string, std::uint32_t> indices;
+				std::unique_ptr<std::unique_ptr<std::string[]>[]> chunks;
+				std::uint32_t count;
+
+			public:
+				StringTable()
+					: chunks(new std::unique_ptr<std::string[]>[maximumChunks]), count(0)
+				{
+					Add({});
+				}
+
+				std::uint32_t Add(const std::string& value)
+				{
+					std::lock_guard<std::mutex> lock{ mutex };
+					auto found = indices.find(value);
+					if (found != indices.end())
+						return found->second;
+					if (count == chunkSize * maximumChunks)
+						throw std::runtime_error("Too many distinct names.");
+					auto& chunk = chunks[count >> chunkBits];
+					if (!chunk)
+						chunk.reset(new std::string[chunkSize]);
+					chunk[count & (chunkSize - 1)] = value;
+					indices.insert({ value, count });
+					return count++;
+				}
+
+				const std::string& Get(std::uint32_t index) const
+				{
+					return chunks[index >> chunkBits][index & (chunkSize - 1)];
+				}
+			};
+
+			// The high bits of an index select a table and the low bits a string within it. Table 0 is
+			// never freed and holds the names interned outside any pool, including the empty string.
+			class StringTables
+			{
+			private:
+				std::mutex mutex;
+				std::unique_ptr<StringTable> tables[maximumPools];
+
+			public:
+				StringTables()
+				{
+					tables[0].reset(new StringTable);
+				}
+
+				std::uint32_t Allocate()
+				{
+					std::lock_guard<std::mutex> lock{ mutex };
+					for (auto slot = 1u; slot < maximumPools; ++slot)
+						if (!tables[slot])
+						{
+							tables[slot].reset(new StringTable);
+							return slot;
+						}
+					// Every slot is taken; the pool's names then live as long as the process.
+					return 0;
+				}
+
+				void Free(std::uint32_t slot)
+				{
+					if (slot == 0)
+						return;
+					std::unique_ptr<StringTable> table;
+					std::lock_guard<std::mutex> lock{ mutex };
+					table.swap(tables[slot]);
+				}
+
+				std::uint32_t Add(std::uint32_t slot, const std::string& value)
+				{
+					return (slot << localBits) | tables[slot]->Add(value);
+				}
+
+				const std::string& Get(std::uint32_t index) const
+				{
+					return tables[index >> localBits]->Get(index & ((1u << localBits) - 1));
+				}
+			};
+
+			StringTables& GetTables()
+			{
+				static StringTables tables;
+				return tables;
+			}
+
+			thread_local std::uint32_t currentSlot = 0;
+		}
+
+		InternedString::Pool::Pool()
+			: slot(GetTables().Allocate())
+		{
+		}
+
+		InternedString::Pool::~Pool()
+		{
+			GetTables().Free(slot);
+		}
+
+		InternedString::Pool::Scope::Scope(const Pool& pool)
+			: previous(currentSlot)
+		{
+			currentSlot = pool.slot;
+		}
+
+		InternedString::Pool::Scope::~Scope()
+		{
+			currentSlot = previous;
+		}
+
+		InternedString::InternedString()
+			: index(0)
+		{
+		}
+
+		InternedString::InternedString(const std::string& value)
+			: index(Intern(value))
+		{
+		}
+
+		InternedString::InternedString(const char* value)
+			: index(Intern(value))
+		{
+		}
+
+		const std::string& InternedString::GetString() const
+		{
+			return GetTables().Get(index);
+		}
+
+		bool InternedString::IsEmpty() const
+		{
+			return index == 0;
+		}
+
+		InternedString::operator const std::string&() const
+		{
+			return GetString();
+		}
+
+		bool operator==(InternedString lhs, InternedString rhs)
+		{
+			// The same name has a different index in each pool it was interned in.
+			if (lhs.index == rhs.index)
+				return true;
+			return (lhs.index >> localBits) != (rhs.index >> localBits) && lhs.GetString() == rhs.GetString();
+		}
+
+		bool operator!=(InternedString lhs, InternedString rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		bool operator==(InternedString lhs, const std::string& rhs)
+		{
+			return lhs.GetString() == rhs;
+		}
+
+		bool operator==(const std::string& lhs, InternedString rhs)
+		{
+			return lhs == rhs.GetString();
+		}
+
+		bool operator!=(InternedString lhs, const std::string& rhs)
+		{
+			return lhs.GetString() != rhs;
+		}
+
+		bool operator!=(const std::string& lhs, InternedString rhs)
+		{
+			return lhs != rhs.GetString();
+		}
+
+		bool operator==(InternedString lhs, const char* rhs)
+		{
+			return lhs.GetString() == rhs;
+		}
+
+		bool operator==(const char* lhs, InternedString rhs)
+		{
+			return lhs == rhs.GetString();
+		}
+
+		bool operator!=(InternedString lhs, const char* rhs)
+		{
+			return lhs.GetString() != rhs;
+		}
+
+		bool operator!=(const char* lhs, InternedString rhs)
+		{
+			return lhs != rhs.GetString();
+		}
+
+		bool operator<(InternedString lhs, InternedString rhs)
+		{
+			return lhs.GetString() < rhs.GetString();
+		}
+
+		std::string operator+(const std::string& lhs, InternedString rhs)
+		{
+			return lhs + rhs.GetString();
+		}
+
+		std::string operator+(InternedString lhs, const std::string& rhs)
+		{
+			return lhs.GetString() + rhs;
+		}
+
+		std::string operator+(const char* lhs, InternedString rhs)
+		{
+			return lhs + rhs.GetString();
+		}
+
+		std::string operator+(InternedString lhs, const char* rhs)
+		{
+			return lhs.GetString() + rhs;
+		}
+
+		std::ostream& operator<<(std::ostream& out, InternedString value)
+		{
+			return out << value.GetString();
+		}
+
+		std::uint32_t InternedString::Intern(const std::string& value)
+		{
+			if (value.empty())
+				return 0;
+			return GetTables().Add(currentSlot, value);
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class InternedString
+		{
+		public:
+			// Owns the names interned while one of its scopes is active on the calling thread, and
+			// frees them when destroyed. Names interned outside any scope live for the whole process.
+			class Pool
+			{
+			private:
+				std::uint32_t slot;
+
+			public:
+				class Scope
+				{
+				private:
+					std::uint32_t previous;
+
+				public:
+					Scope(const Pool& pool);
+					Scope(const Scope& rhs) = delete;
+					~Scope();
+
+					Scope& operator=(const Scope& rhs) = delete;
+				};
+
+				Pool();
+				Pool(const Pool& rhs) = delete;
+				~Pool();
+
+				Pool& operator=(const Pool& rhs) = delete;
+			};
+
+		private:
+			std::uint32_t index;
+
+		public:
+			InternedString();
+			InternedString(const std::string& value);
+			InternedString(const char* value);
+
+			const std::string& GetString() const;
+			bool IsEmpty() const;
+			operator const std::string&() const;
+
+			friend bool operator==(InternedString lhs, InternedString rhs);
+			friend bool operator!=(InternedString lhs, InternedString rhs);
+			friend bool operator==(InternedString lhs, const std::string& rhs);
+			friend bool operator==(const std::string& lhs, InternedString rhs);
+			friend bool operator!=(InternedString lhs, const std::string& rhs);
+			friend bool operator!=(const std::string& lhs, InternedString rhs);
+			friend bool operator==(InternedString lhs, const char* rhs);
+			friend bool operator==(const char* lhs, InternedString rhs);
+			friend bool operator!=(InternedString lhs, const char* rhs);
+			friend bool operator!=(const char* lhs, InternedString rhs);
+			friend bool operator<(InternedString lhs, InternedString rhs);
+			friend std::string operator+(const std::string& lhs, InternedString rhs);
+			friend std::string operator+(InternedString lhs, const std::string& rhs);
+			friend std::string operator+(const char* lhs, InternedString rhs);
+			friend std::string operator+(InternedString lhs, const char* rhs);
+			friend std::ostream& operator<<(std::ostream& out, InternedString value);
+
+		private:
+			static std::uint32_t Intern(const std::string& value);
+		};
+	}
+}
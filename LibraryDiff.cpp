@@ -0,0 +1,304 @@
+#include "LibraryDiff.h"
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <set>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			// 64-bit FNV-1a. Strings are length prefixed so adjacent fields cannot run into each other.
+			class StructuralHash
+			{
+			private:
+				std::uint64_t value = 14695981039346656037ull;
+
+			public:
+				std::uint64_t GetValue() const
+				{
+					return value;
+				}
+
+				void Add(const void* data, std::size_t size)
+				{
+					auto bytes = static_cast<const unsigned char*>(data);
+					for (auto index = 0u; index < size; ++index)
+					{
+						value ^= bytes[index];
+						value *= 1099511628211ull;
+					}
+				}
+
+				void Add(std::uint64_t number)
+				{
+					Add(&number, sizeof(number));
+				}
+
+				void Add(const std::string& text)
+				{
+					Add(text.size());
+					Add(text.data(), text.size());
+				}
+
+				void Add(const GUID& guid)
+				{
+					Add(&guid, sizeof(guid));
+				}
+
+				void Add(const Type& type)
+				{
+					Add(static_cast<std::uint64_t>(type.Indirection));
+					Add(static_cast<std::uint64_t>(type.TypeEnum));
+					Add(type.CustomName.GetString());
+					Add(type.IsArray ? 1u : 0u);
+					Add(type.ArraySize);
+					Add(static_cast<std::uint64_t>(type.ElementType));
+				}
+			};
+
+			std::uint64_t GetInvokeKind(const Function& value)
+			{
+				return (value.IsPropGet ? 1u : 0u) | (value.IsPropPut ? 2u : 0u) | (value.IsPropPutRef ? 4u : 0u);
+			}
+
+			const std::string& GetName(const Interface& value)
+			{
+				return value.Name;
+			}
+
+			const std::string& GetName(const Record& value)
+			{
+				return value.Name;
+			}
+
+			const std::string& GetName(const Enum& value)
+			{
+				return value.Name;
+			}
+		}
+
+		LibraryDiff::LibraryDiff(const Library& oldLibrary, const Library& newLibrary)
+		{
+			Compare("interface", oldLibrary.Interfaces, newLibrary.Interfaces);
+			Compare("record", oldLibrary.Records, newLibrary.Records);
+			Compare("enum", oldLibrary.Enums, newLibrary.Enums);
+		}
+
+		const std::vector<Change>& LibraryDiff::GetChanges() const
+		{
+			return changes;
+		}
+
+		bool LibraryDiff::IsBreaking() const
+		{
+			return std::any_of(changes.begin(), changes.end(), [](auto& change)
+			{
+				return change.Kind == ChangeKind::Removed || change.Kind == ChangeKind::Breaking;
+			});
+		}
+
+		void LibraryDiff::Report(std::ostream& out) const
+		{
+			std::size_t counts[4] = {};
+			for (auto& change : changes)
+			{
+				++counts[static_cast<std::size_t>(change.Kind)];
+				out << "  " << std::left << std::setw(10) << GetKindName(change.Kind)
+					<< std::setw(10) << change.Category << change.Name << std::endl;
+			}
+			out << counts[static_cast<std::size_t>(ChangeKind::Added)] << " added, "
+				<< counts[static_cast<std::size_t>(ChangeKind::Removed)] << " removed, "
+				<< counts[static_cast<std::size_t>(ChangeKind::Extended)] << " extended, "
+				<< counts[static_cast<std::size_t>(ChangeKind::Breaking)] << " breaking" << std::endl;
+		}
+
+		Library LibraryDiff::SelectChangedInterfaces(const Library& library) const
+		{
+			std::unordered_map<std::string, const Interface*> interfaces;
+			for (auto& iface : library.Interfaces)
+				interfaces.emplace(iface.Name, &iface);
+
+			// Changed interfaces are kept together with the bases and parameter types they need to compile.
+			std::set<std::string> selected;
+			std::vector<const Interface*> pending;
+			auto select = [&](const std::string& name)
+			{
+				auto iter = interfaces.find(name);
+				if (iter != interfaces.end() && selected.insert(name).second)
+					pending.push_back(iter->second);
+			};
+			for (auto& change : changes)
+				if (change.Kind != ChangeKind::Removed && change.Category == std::string{ "interface" })
+					select(change.Name);
+			while (!pending.empty())
+			{
+				auto iface = pending.back();
+				pending.pop_back();
+				select(iface->Base);
+				for (auto& function : iface->Functions)
+				{
+					if (function.Retval.TypeEnum == TypeEnum::Interface)
+						select(function.Retval.CustomName);
+					for (auto& argument : function.ArgList)
+						if (argument.Type.TypeEnum == TypeEnum::Interface)
+							select(argument.Type.CustomName);
+				}
+			}
+
+			Library result;
+			result.Name = library.Name;
+			result.OutputName = library.OutputName + "Changes";
+			result.FileName = library.FileName;
+			result.Libid = library.Libid;
+			result.MajorVersion = library.MajorVersion;
+			result.MinorVersion = library.MinorVersion;
+			// References are left out: their headers are not generated alongside the changes.
+			result.Enums = library.Enums;
+			result.Aliases = library.Aliases;
+			result.Records = library.Records;
+			result.Strings = library.Strings;
+			std::set<std::string> identifiers{ "LIBID_" + library.Name };
+			for (auto& iface : library.Interfaces)
+				if (selected.find(iface.Name) != selected.end())
+				{
+					result.Interfaces.push_back(iface);
+					identifiers.insert(iface.Prefix + iface.Name);
+				}
+			for (auto& identifier : library.Identifiers)
+				if (identifiers.find(identifier.Name) != identifiers.end())
+					result.Identifiers.push_back(identifier);
+			return result;
+		}
+
+		template <typename T>
+		void LibraryDiff::Compare(const char* category, const std::vector<T>& oldValues, const std::vector<T>& newValues)
+		{
+			Signatures oldSignatures;
+			for (auto& value : oldValues)
+				oldSignatures.emplace(GetName(value), Hash(value));
+			Signatures newSignatures;
+			for (auto& value : newValues)
+				newSignatures.emplace(GetName(value), Hash(value));
+
+			for (auto& value : oldValues)
+			{
+				auto& name = GetName(value);
+				auto iter = newSignatures.find(name);
+				if (iter == newSignatures.end())
+				{
+					changes.push_back({ ChangeKind::Removed, category, name });
+					continue;
+				}
+				auto& oldSignature = oldSignatures[name];
+				if (oldSignature.Header != iter->second.Header || oldSignature.Members != iter->second.Members)
+					changes.push_back({ Classify(oldSignature, iter->second), category, name });
+			}
+			for (auto& value : newValues)
+				if (oldSignatures.find(GetName(value)) == oldSignatures.end())
+					changes.push_back({ ChangeKind::Added, category, GetName(value) });
+		}
+
+		ChangeKind LibraryDiff::Classify(const Signature& oldSignature, const Signature& newSignature)
+		{
+			if (oldSignature.Header != newSignature.Header)
+				return ChangeKind::Breaking;
+			// New members are compatible as long as every existing one is still there unchanged.
+			for (auto& member : oldSignature.Members)
+			{
+				auto iter = newSignature.Members.find(member.first);
+				if (iter == newSignature.Members.end() || iter->second != member.second)
+					return ChangeKind::Breaking;
+			}
+			return ChangeKind::Extended;
+		}
+
+		LibraryDiff::Signature LibraryDiff::Hash(const Interface& value)
+		{
+			StructuralHash header;
+			header.Add(value.Iid);
+			header.Add(value.Base);
+			header.Add(value.BaseIid);
+			header.Add(value.SupportsDispatch ? 1u : 0u);
+			header.Add(value.VtblOffset);
+
+			Signature result{ header.GetValue(), {} };
+			for (auto& function : value.Functions)
+			{
+				// Dispatch-only members have no vtable slot; a property's accessors share their DISPID.
+				StructuralHash key;
+				if (function.VtblOffset == 0 && function.IsDispatchOnly)
+				{
+					key.Add(static_cast<std::uint64_t>(function.MemberId));
+					key.Add(GetInvokeKind(function));
+				}
+				else
+					key.Add(function.VtblOffset);
+
+				StructuralHash member;
+				member.Add(function.VtblOffset);
+				member.Add(static_cast<std::uint64_t>(function.MemberId));
+				member.Add(function.IsDispatchOnly ? 1u : 0u);
+				member.Add(GetInvokeKind(function));
+				member.Add(function.Retval);
+				member.Add(function.ArgList.size());
+				for (auto& argument : function.ArgList)
+				{
+					member.Add(argument.Type);
+					member.Add((argument.In ? 1u : 0u) | (argument.Out ? 2u : 0u) | (argument.Retval ? 4u : 0u));
+				}
+				result.Members[key.GetValue()] = member.GetValue();
+			}
+			return result;
+		}
+
+		LibraryDiff::Signature LibraryDiff::Hash(const Record& value)
+		{
+			// The member count is part of the header: appending a field changes the record size.
+			StructuralHash header;
+			header.Add(value.Guid);
+			header.Add(value.Alignment);
+			header.Add(value.Members.size());
+
+			Signature result{ header.GetValue(), {} };
+			for (auto index = 0u; index < value.Members.size(); ++index)
+			{
+				StructuralHash member;
+				member.Add(value.Members[index].Type);
+				result.Members[index] = member.GetValue();
+			}
+			return result;
+		}
+
+		LibraryDiff::Signature LibraryDiff::Hash(const Enum& value)
+		{
+			// Keyed by name, so adding a value anywhere only extends the enum; removing or renumbering one breaks it.
+			Signature result{ StructuralHash{}.GetValue(), {} };
+			for (auto& enumValue : value.Values)
+			{
+				StructuralHash key;
+				key.Add(enumValue.Name);
+				result.Members[key.GetValue()] = static_cast<std::uint64_t>(enumValue.Value);
+			}
+			return result;
+		}
+
+		const char* LibraryDiff::GetKindName(ChangeKind kind)
+		{
+			switch (kind)
+			{
+			case ChangeKind::Added:
+				return "added";
+			case ChangeKind::Removed:
+				return "removed";
+			case ChangeKind::Extended:
+				return "extended";
+			case ChangeKind::Breaking:
+				return "breaking";
+			}
+			return "";
+		}
+	}
+}
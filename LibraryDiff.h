@@ -0,0 +1,66 @@
+#pragma once
+#include "DataTypes.h"
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		enum class ChangeKind
+		{
+			Added,
+			Removed,
+			Extended,
+			Breaking
+		};
+
+		struct Change
+		{
+			ChangeKind Kind;
+			const char* Category;
+			std::string Name;
+		};
+
+		// Compares two versions of a library by structural hashes of its interfaces, records and enums.
+		// Names of functions, parameters and record fields are not hashed; only what affects the binary
+		// contract is: vtable offsets, DISPIDs, types, base interfaces, alignment and enum values.
+		// Members are matched by vtable slot, by DISPID for dispatch-only members, by position for
+		// record fields and by name for enum values.
+		class LibraryDiff
+		{
+		private:
+			struct Signature
+			{
+				std::uint64_t Header;
+				std::map<std::uint64_t, std::uint64_t> Members;
+			};
+
+			using Signatures = std::unordered_map<std::string, Signature>;
+
+			std::vector<Change> changes;
+
+		public:
+			LibraryDiff(const Library& oldLibrary, const Library& newLibrary);
+
+			const std::vector<Change>& GetChanges() const;
+			bool IsBreaking() const;
+			void Report(std::ostream& out) const;
+			Library SelectChangedInterfaces(const Library& library) const;
+
+		private:
+			template <typename T>
+			void Compare(const char* category, const std::vector<T>& oldValues, const std::vector<T>& newValues);
+			static ChangeKind Classify(const Signature& oldSignature, const Signature& newSignature);
+
+			static Signature Hash(const Interface& value);
+			static Signature Hash(const Record& value);
+			static Signature Hash(const Enum& value);
+			static const char* GetKindName(ChangeKind kind);
+		};
+	}
+}
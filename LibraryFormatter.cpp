@@ -5,13 +5,15 @@
 #include "RecordFormatter.h"
 #include "IdentifierFormatter.h"
 #include "CoclassFormatter.h"
+#include "FragmentCache.h"
+#include "SupportFormatter.h"
 
 namespace Com
 {
 	namespace Import
 	{
-		LibraryFormatter::LibraryFormatter(const Library& value, LibraryFormat format, bool implement)
-			: value(value), format(format), implement(implement)
+		LibraryFormatter::LibraryFormatter(const Library& value, LibraryFormat format, const GeneratorOptions& options)
+			: value(value), format(format), options(options)
 		{
 		}
 
@@ -37,6 +39,20 @@ namespace Com
 				<< "#include <Com/Com.h>" << std::endl;
 			for (auto& reference : value.References)
 				out << "#include \"" << reference << "\"" << std::endl;
+			out << Format(SupportFormat::AsCalls);
+			auto implementDispatch = options.Implement && HasDispatchCoclasses();
+			if (implementDispatch || HasDispatchOnlyMembers())
+				out << Format(SupportFormat::AsDispatch);
+			if (implementDispatch)
+				out << Format(SupportFormat::AsDispatchImplementation);
+			if (options.Implement && !value.Coclasses.empty())
+				out << Format(SupportFormat::AsInterfaceTable);
+			if (options.BstrWrappers)
+				out << Format(SupportFormat::AsStrings);
+			if (options.SafeArrayViews)
+				out << Format(SupportFormat::AsSafeArrays);
+			if (options.HresultWrappers)
+				out << "#include <new>" << std::endl;
 			out << "#pragma pack(push, 8)" << std::endl
 				<< "namespace " << value.Name << std::endl
 				<< "{" << std::endl;
@@ -50,16 +66,19 @@ namespace Com
 			for (auto& record : value.Records)
 				out << Format(record);
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsNative, implement ? "raw_" : "");
+				out << Format(iface, InterfaceFormat::AsNative, options.Implement ? "raw_" : "");
 			for (auto& identifier : value.Identifiers)
 				out << Format(identifier);
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsWrapper);
+				out << Format(iface, InterfaceFormat::AsWrapper, "", "", options);
 			for (auto& iface : value.Interfaces)
-				out << Format(iface, InterfaceFormat::AsWrapperFunctions, implement ? "raw_" : "");
-			if (implement)
+				out << Format(iface, InterfaceFormat::AsWrapperFunctions, options.Implement ? "raw_" : "", "", options);
+			if (options.Implement)
+			{
+				FragmentCache fragments;
 				for (auto& coclass : value.Coclasses)
-					out << Format(coclass, CoclassFormat::AsBase);
+					out << Format(coclass, CoclassFormat::AsBase, value.Name, value.OutputName, &value.Interfaces, &fragments);
+			}
 			out << "}" << std::endl;
 			out << "namespace Com" << std::endl
 				<< "{" << std::endl;
@@ -69,9 +88,27 @@ namespace Com
 			out << "#pragma pack(pop)" << std::endl;
 		}
 
-		LibraryFormatter Format(const Library& library, LibraryFormat format, bool implement)
+		bool LibraryFormatter::HasDispatchOnlyMembers() const
+		{
+			for (auto& iface : value.Interfaces)
+				for (auto& function : iface.Functions)
+					if (function.VtblOffset == 0 && function.IsDispatchOnly)
+						return true;
+			return false;
+		}
+
+		bool LibraryFormatter::HasDispatchCoclasses() const
+		{
+			for (auto& coclass : value.Coclasses)
+				for (auto& iface : coclass.Interfaces)
+					if (iface.SupportsDispatch)
+						return true;
+			return false;
+		}
+
+		LibraryFormatter Format(const Library& library, LibraryFormat format, const GeneratorOptions& options)
 		{
-			return{ library, format, implement };
+			return{ library, format, options };
 		}
 	}
 }
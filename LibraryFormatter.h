@@ -1,5 +1,6 @@
 #pragma once
 #include "DataTypes.h"
+#include "Options.h"
 #include <iostream>
 
 namespace Com
@@ -16,18 +17,20 @@ namespace Com
 		private:
 			const Library& value;
 			LibraryFormat format;
-			bool implement;
+			GeneratorOptions options;
 
 		public:
-			LibraryFormatter(const Library& value, LibraryFormat format, bool implement);
+			LibraryFormatter(const Library& value, LibraryFormat format, const GeneratorOptions& options);
 
 			std::ostream& Write(std::ostream& out) const;
 			friend std::ostream& operator<<(std::ostream& out, const LibraryFormatter& value);
 
 		private:
 			void WriteAsImport(std::ostream& out) const;
+			bool HasDispatchOnlyMembers() const;
+			bool HasDispatchCoclasses() const;
 		};
 
-		LibraryFormatter Format(const Library& library, LibraryFormat format, bool implement = false);
+		LibraryFormatter Format(const Library& library, LibraryFormat format, const GeneratorOptions& options = GeneratorOptions{});
 	}
 }
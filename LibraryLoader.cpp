@@ -2,6 +2,8 @@
 #include "TypeLibrary.h"
 #include "TypeInfo.h"
 #include "RecordSorter.h"
+#include "Statistics.h"
+#include "TraceEvents.h"
 #include <exception>
 #include <stdexcept>
 #include <iostream>
@@ -13,22 +15,38 @@ namespace Com
 		LoadLibraryResult LibraryLoader::Load(const std::string& typeLibraryFileName)
 		{
 			LoadLibraryResult result;
+			Load(typeLibraryFileName, result, nullptr);
+			return result;
+		}
+
+		void LibraryLoader::Load(const std::string& typeLibraryFileName, LoadLibraryResult& result, const std::function<void(Library&)>& imported)
+		{
 			result.PrimaryLibrary = ImportTypeLibrary(typeLibraryFileName);
+			if (imported)
+				imported(result.PrimaryLibrary);
 			while (!pendingLibraries.empty())
 			{
 				std::string fileName = *pendingLibraries.begin();
 				pendingLibraries.erase(pendingLibraries.begin());
 				result.ReferencedLibraries.push_back(ImportTypeLibrary(fileName));
+				if (imported)
+					imported(result.ReferencedLibraries.back());
 			}
-			return result;
+		}
+
+		Library LibraryLoader::LoadPrimary(const std::string& typeLibraryFileName)
+		{
+			// References are still listed in Library::References, but are not imported.
+			auto library = ImportTypeLibrary(typeLibraryFileName);
+			pendingLibraries.clear();
+			return library;
 		}
 
 		void LibraryLoader::Reference(Pointer<ITypeLib> reference)
 		{
-			TypeLibrary typeLibrary{ reference };
 			try
 			{
-				auto path = typeLibrary.QueryPath();
+				auto& path = GetPath(reference);
 				currentReferences.insert(path);
 				if (loadedLibraries.find(path) != loadedLibraries.end())
 					return;
@@ -36,7 +54,7 @@ namespace Com
 			}
 			catch (const std::exception& exception)
 			{
-				std::cout << "Unable to reference type library: " << typeLibrary.GetName() << std::endl;
+				std::cout << "Unable to reference type library: " << Identify(reference).Name << std::endl;
 				std::cerr << exception.what() << std::endl;
 			}
 		}
@@ -54,14 +72,19 @@ namespace Com
 
 		Library LibraryLoader::ImportTypeLibrary(const std::string& typeLibraryFileName)
 		{
+			COM_IMPORT_TIME_PHASE("decode " + typeLibraryFileName);
+			TraceEvents::Span span{ "import", typeLibraryFileName };
 			std::cout << "Importing: " << typeLibraryFileName << std::endl;
 			loadedLibraries.insert(typeLibraryFileName);
 			currentReferences.clear();
 
 			TypeLibrary typeLibrary(typeLibraryFileName);
 			Library library;
+			library.Strings = std::make_shared<InternedString::Pool>();
+			InternedString::Pool::Scope strings{ *library.Strings };
 			library.Name = typeLibrary.GetName();
 			library.OutputName = GetTitle(typeLibraryFileName);
+			library.FileName = typeLibraryFileName;
 			library.Libid = typeLibrary.GetId();
 			library.MajorVersion = typeLibrary.GetMajorVersion();
 			library.MinorVersion = typeLibrary.GetMinorVersion();
@@ -71,7 +94,10 @@ namespace Com
 			for (auto index = 0u; index < count; ++index)
 				LoadType(typeLibrary, index, library);
 
-			RecordSorter::SortRecords(library.Records);
+			{
+				COM_IMPORT_TIME_PHASE("sort records");
+				RecordSorter::SortRecords(library.Records);
+			}
 
 			for (auto& reference : currentReferences)
 				library.References.push_back(GetTitle(reference) + ".h");
@@ -82,6 +108,7 @@ namespace Com
 		void LibraryLoader::LoadType(TypeLibrary& typeLibrary, UINT index, Library& library)
 		{
 			TypeInfo typeInfo{ typeLibrary.GetTypeInfo(index) };
+			TraceEvents::Span span{ "decode", TraceEvents::IsEnabled() ? typeInfo.GetName() : std::string{} };
 			switch (typeInfo.GetTypeKind())
 			{
 			case TKIND_INTERFACE:
@@ -1,6 +1,7 @@
 #pragma once
 #include "DataTypes.h"
 #include "Loader.h"
+#include <functional>
 #include <set>
 #include <string>
 
@@ -19,6 +20,8 @@ namespace Com
 
 		public:
 			LoadLibraryResult Load(const std::string& typeLibraryFileName);
+			void Load(const std::string& typeLibraryFileName, LoadLibraryResult& result, const std::function<void(Library&)>& imported);
+			Library LoadPrimary(const std::string& typeLibraryFileName);
 			void Reference(Pointer<ITypeLib> reference) final;
 
 		private:
@@ -0,0 +1,217 @@
+#include "LibrarySynthesizer.h"
+#include <map>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			struct Preset
+			{
+				unsigned long Interfaces;
+				unsigned long Functions;
+				unsigned long Parameters;
+				unsigned long Records;
+				unsigned long Enums;
+				unsigned long Coclasses;
+			};
+
+			const std::map<std::string, Preset> presets
+			{
+				{ "tiny", { 4, 4, 2, 2, 2, 1 } },
+				{ "small", { 50, 8, 2, 10, 20, 10 } },
+				{ "medium", { 500, 12, 3, 50, 100, 50 } },
+				{ "office", { 2000, 40, 4, 150, 600, 250 } }
+			};
+
+			const unsigned long enumKind = 1;
+			const unsigned long recordKind = 2;
+			const unsigned long interfaceKind = 3;
+			const unsigned long coclassKind = 4;
+			const unsigned long valuesPerEnum = 8;
+			const unsigned long fieldsPerRecord = 4;
+			const unsigned long interfacesPerCoclass = 2;
+			const MEMBERID firstFunction = 0x60020000;
+
+			const Preset& GetPreset(const std::string& size)
+			{
+				auto found = presets.find(size);
+				if (found == presets.end())
+					throw std::runtime_error("Unknown benchmark size: " + size);
+				return found->second;
+			}
+		}
+
+		const std::vector<std::string> LibrarySynthesizer::SettingNames
+		{
+			"size", "interfaces", "functions", "parameters", "records", "enums", "coclasses"
+		};
+
+		LibrarySynthesizer::LibrarySynthesizer(const BenchmarkSettings& settings)
+			: size(settings.GetString("size", "medium"))
+		{
+			auto& preset = GetPreset(size);
+			interfaces = settings.GetNumber("interfaces", preset.Interfaces);
+			functions = settings.GetNumber("functions", preset.Functions);
+			parameters = settings.GetNumber("parameters", preset.Parameters);
+			records = settings.GetNumber("records", preset.Records);
+			enums = settings.GetNumber("enums", preset.Enums);
+			coclasses = settings.GetNumber("coclasses", preset.Coclasses);
+		}
+
+		Library LibrarySynthesizer::Synthesize() const
+		{
+			Library library;
+			library.Strings = std::make_shared<InternedString::Pool>();
+			InternedString::Pool::Scope strings{ *library.Strings };
+			library.Name = "Synthetic";
+			library.OutputName = "Synthetic";
+			library.FileName = "Synthetic.tlb";
+			library.Libid = CreateGuid(0, 0);
+			library.MajorVersion = 1;
+			library.MinorVersion = 0;
+			library.Identifiers.push_back({ "LIBID_" + library.Name, library.Libid });
+			for (auto index = 0ul; index < enums; ++index)
+				library.Enums.push_back(CreateEnum(index));
+			for (auto index = 0ul; index < records; ++index)
+				library.Records.push_back(CreateRecord(index));
+			for (auto index = 0ul; index < interfaces; ++index)
+			{
+				library.Interfaces.push_back(CreateInterface(index));
+				auto& value = library.Interfaces.back();
+				library.Identifiers.push_back({ value.Prefix + value.Name, value.Iid });
+			}
+			for (auto index = 0ul; index < coclasses; ++index)
+			{
+				library.Coclasses.push_back(CreateCoclass(library, index));
+				auto& value = library.Coclasses.back();
+				library.Identifiers.push_back({ "CLSID_" + value.Name, value.Clsid });
+			}
+			return library;
+		}
+
+		void LibrarySynthesizer::WriteSettings(std::ostream& out) const
+		{
+			out << "  \"size\": \"" << size << "\"," << std::endl
+				<< "  \"interfaces\": " << interfaces << "," << std::endl
+				<< "  \"functions\": " << functions << "," << std::endl
+				<< "  \"parameters\": " << parameters << "," << std::endl
+				<< "  \"records\": " << records << "," << std::endl
+				<< "  \"enums\": " << enums << "," << std::endl
+				<< "  \"coclasses\": " << coclasses << "," << std::endl;
+		}
+
+		Enum LibrarySynthesizer::CreateEnum(unsigned long index) const
+		{
+			Enum value{ "Enum" + std::to_string(index),{} };
+			for (auto member = 0ul; member < valuesPerEnum; ++member)
+			{
+				auto memberValue = static_cast<LONG>(index % 2 == 0 ? member : 1ul << member);
+				value.Values.push_back({ value.Name + "_Value" + std::to_string(member), memberValue });
+			}
+			return value;
+		}
+
+		Record LibrarySynthesizer::CreateRecord(unsigned long index) const
+		{
+			Record value{ "Record" + std::to_string(index), CreateGuid(recordKind, index), 4,{} };
+			for (auto field = 0ul; field < fieldsPerRecord; ++field)
+			{
+				auto type = CreateParameterType(field);
+				if (type.TypeEnum == TypeEnum::Interface)
+					type = { 0, TypeEnum::Int32, "", false, 0, TypeEnum::Empty };
+				value.Members.push_back({ "Field" + std::to_string(field), type, false, false, false });
+			}
+			return value;
+		}
+
+		Interface LibrarySynthesizer::CreateInterface(unsigned long index) const
+		{
+			Interface value{ CreateGuid(interfaceKind, index), "IID_", "IInterface" + std::to_string(index), "IUnknown", IID_IUnknown, false, 12,{}, false };
+			if (index % 2 == 1)
+			{
+				value.Base = "IDispatch";
+				value.BaseIid = IID_IDispatch;
+				value.SupportsDispatch = true;
+				value.VtblOffset += 16;
+			}
+			// Every fourth interface is a pure dispinterface, whose members are only reachable through Invoke.
+			auto isDispatchOnly = index % 4 == 3;
+			for (auto function = 0ul; function < functions; ++function)
+			{
+				value.Functions.push_back(CreateFunction(index, function));
+				auto& created = value.Functions.back();
+				created.IsDispatchOnly = isDispatchOnly;
+				created.VtblOffset = isDispatchOnly ? 0 : value.VtblOffset + 4 * function;
+			}
+			return value;
+		}
+
+		Coclass LibrarySynthesizer::CreateCoclass(const Library& library, unsigned long index) const
+		{
+			Coclass value{ "Class" + std::to_string(index), CreateGuid(coclassKind, index),{} };
+			for (auto implemented = 0ul; implemented < interfacesPerCoclass && implemented < library.Interfaces.size(); ++implemented)
+				value.Interfaces.push_back(library.Interfaces[(index + implemented) % library.Interfaces.size()]);
+			return value;
+		}
+
+		Function LibrarySynthesizer::CreateFunction(unsigned long interfaceIndex, unsigned long index) const
+		{
+			auto rootName = (index % 4 == 0 ? "Method" : "Property") + std::to_string(index / 4);
+			Function value{ 0, static_cast<MEMBERID>(firstFunction + index), rootName, rootName,{ 0, TypeEnum::Hresult, "", false, 0, TypeEnum::Empty },{}, false, false, false, false, false };
+			switch (index % 4)
+			{
+			case 1:
+				value.Name = "get_" + rootName;
+				value.IsProperty = value.IsPropGet = true;
+				value.ArgList.push_back({ "retval", CreateParameterType(interfaceIndex + index), false, true, true });
+				++value.ArgList.back().Type.Indirection;
+				break;
+			case 2:
+				value.Name = "put_" + rootName;
+				value.IsProperty = value.IsPropPut = true;
+				value.ArgList.push_back({ "value", CreateParameterType(interfaceIndex + index - 1), true, false, false });
+				break;
+			default:
+				for (auto parameter = 0ul; parameter < parameters; ++parameter)
+					value.ArgList.push_back({ "argument" + std::to_string(parameter), CreateParameterType(interfaceIndex + index + parameter), true, parameter % 3 == 2, false });
+				value.ArgList.push_back({ "retval", CreateParameterType(interfaceIndex + index + parameters), false, true, true });
+				++value.ArgList.back().Type.Indirection;
+				break;
+			}
+			for (auto& argument : value.ArgList)
+				if (argument.Out && !argument.Retval)
+					++argument.Type.Indirection;
+			return value;
+		}
+
+		Type LibrarySynthesizer::CreateParameterType(unsigned long index) const
+		{
+			switch (index % 6)
+			{
+			case 0: return{ 0, TypeEnum::Int32, "", false, 0, TypeEnum::Empty };
+			case 1: return{ 0, TypeEnum::String, "", false, 0, TypeEnum::Empty };
+			case 2: return{ 0, TypeEnum::Double, "", false, 0, TypeEnum::Empty };
+			case 3: return{ 0, TypeEnum::Bool, "", false, 0, TypeEnum::Empty };
+			case 4:
+				if (enums > 0)
+					return{ 0, TypeEnum::Enum, "Enum" + std::to_string(index % enums), false, 0, TypeEnum::Empty };
+				return{ 0, TypeEnum::Int32, "", false, 0, TypeEnum::Empty };
+			default:
+				if (interfaces > 0)
+					return{ 1, TypeEnum::Interface, "IInterface" + std::to_string(index % interfaces), false, 0, TypeEnum::Empty };
+				return{ 0, TypeEnum::Unknown, "IUnknown", false, 0, TypeEnum::Empty };
+			}
+		}
+
+		GUID LibrarySynthesizer::CreateGuid(unsigned long kind, unsigned long index)
+		{
+			GUID value{ 0, static_cast<unsigned short>(kind), 0xF0E7, { 0x8E, 0x4B, 0x3A, 0x11, 0x00, 0x00, 0x00, 0x01 } };
+			// Assigned separately because Data1 is narrower than unsigned long outside Windows.
+			value.Data1 = index;
+			return value;
+		}
+	}
+}
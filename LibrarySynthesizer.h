@@ -0,0 +1,41 @@
+#pragma once
+#include "BenchmarkSettings.h"
+#include "DataTypes.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class LibrarySynthesizer
+		{
+		private:
+			std::string size;
+			unsigned long interfaces;
+			unsigned long functions;
+			unsigned long parameters;
+			unsigned long records;
+			unsigned long enums;
+			unsigned long coclasses;
+
+		public:
+			static const std::vector<std::string> SettingNames;
+
+			LibrarySynthesizer(const BenchmarkSettings& settings);
+
+			Library Synthesize() const;
+			void WriteSettings(std::ostream& out) const;
+
+		private:
+			Enum CreateEnum(unsigned long index) const;
+			Record CreateRecord(unsigned long index) const;
+			Interface CreateInterface(unsigned long index) const;
+			Coclass CreateCoclass(const Library& library, unsigned long index) const;
+			Function CreateFunction(unsigned long interfaceIndex, unsigned long index) const;
+			Type CreateParameterType(unsigned long index) const;
+			static GUID CreateGuid(unsigned long kind, unsigned long index);
+		};
+	}
+}
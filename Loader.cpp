@@ -1,4 +1,6 @@
 #include "Loader.h"
+#include "TypeLibrary.h"
+#include <cstring>
 #include <stdexcept>
 
 namespace Com
@@ -16,10 +18,57 @@ namespace Com
 		}
 
 		void Loader::AddReference(Pointer<ITypeLib> typeLibrary)
+		{
+			GetCheckedInstance("AddReference").Reference(typeLibrary);
+		}
+
+		const LibraryIdentity& Loader::Identify(Pointer<ITypeLib> typeLibrary)
+		{
+			return Find(typeLibrary);
+		}
+
+		const std::string& Loader::GetPath(Pointer<ITypeLib> typeLibrary)
+		{
+			auto& identity = Find(typeLibrary);
+			if (identity.Path.empty())
+				identity.Path = TypeLibrary::QueryPath(identity.Attributes);
+			return identity.Path;
+		}
+
+		LibraryIdentity& Loader::Find(Pointer<ITypeLib> typeLibrary)
+		{
+			auto& libraries = GetCheckedInstance("Identify").libraries;
+
+			TypeLibrary library{ typeLibrary };
+			auto& attributes = library.GetAttributes();
+			Key key{ attributes.guid, attributes.lcid, attributes.syskind, attributes.wMajorVerNum, attributes.wMinorVerNum };
+			auto found = libraries.find(key);
+			if (found != libraries.end())
+				return found->second;
+
+			LibraryIdentity value{ library.GetName(), attributes,{} };
+			return libraries.insert({ key, value }).first->second;
+		}
+
+		bool Loader::Key::operator<(const Key& rhs) const
+		{
+			auto order = std::memcmp(&Libid, &rhs.Libid, sizeof(GUID));
+			if (order != 0)
+				return order < 0;
+			if (Lcid != rhs.Lcid)
+				return Lcid < rhs.Lcid;
+			if (SysKind != rhs.SysKind)
+				return SysKind < rhs.SysKind;
+			if (MajorVersion != rhs.MajorVersion)
+				return MajorVersion < rhs.MajorVersion;
+			return MinorVersion < rhs.MinorVersion;
+		}
+
+		Loader& Loader::GetCheckedInstance(const char* function)
 		{
 			if (GetInstance() == nullptr)
-				throw std::runtime_error("An instance of loader must exist prior to calling AddReference.");
-			GetInstance()->Reference(typeLibrary);
+				throw std::runtime_error(std::string{ "An instance of loader must exist prior to calling " } + function + ".");
+			return *GetInstance();
 		}
 
 		Loader*& Loader::GetInstance()
@@ -1,12 +1,36 @@
 #pragma once
 #include <Com/Com.h>
+#include <map>
+#include <string>
 
 namespace Com
 {
 	namespace Import
 	{
+		struct LibraryIdentity
+		{
+			std::string Name;
+			TLIBATTR Attributes;
+			std::string Path;
+		};
+
 		class Loader
 		{
+		private:
+			struct Key
+			{
+				GUID Libid;
+				LCID Lcid;
+				SYSKIND SysKind;
+				WORD MajorVersion;
+				WORD MinorVersion;
+
+				bool operator<(const Key& rhs) const;
+			};
+
+			// Keyed by the library attributes rather than by COM identity, so that no entry keeps its library alive.
+			std::map<Key, LibraryIdentity> libraries;
+
 		public:
 			Loader();
 			~Loader();
@@ -14,8 +38,12 @@ namespace Com
 			virtual void Reference(Pointer<ITypeLib> typeLibrary) = 0;
 
 			static void AddReference(Pointer<ITypeLib> typeLibrary);
+			static const LibraryIdentity& Identify(Pointer<ITypeLib> typeLibrary);
+			static const std::string& GetPath(Pointer<ITypeLib> typeLibrary);
 
 		private:
+			static LibraryIdentity& Find(Pointer<ITypeLib> typeLibrary);
+			static Loader& GetCheckedInstance(const char* function);
 			static Loader*& GetInstance();
 		};
 	}
@@ -0,0 +1,25 @@
+#include "LowMemoryImport.h"
+#include "LibraryLoader.h"
+#include "CodeGenerator.h"
+#include "Statistics.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		void LowMemoryImport::Load(const std::string& typeLibraryFileName, const GeneratorOptions& options, CodeGenerator& generator, LoadLibraryResult& result)
+		{
+			COM_IMPORT_TIME_PHASE("load and write");
+			auto referenceOptions = CodeGenerator::GetReferenceOptions(options);
+			auto isPrimary = true;
+			LibraryLoader loader;
+			loader.Load(typeLibraryFileName, result, [&](Library& library)
+			{
+				generator.GenerateImport(library, isPrimary ? options : referenceOptions);
+				if (!isPrimary || !options.Implement)
+					CodeGenerator::Summarize(library);
+				isPrimary = false;
+			});
+		}
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "DataTypes.h"
+#include "Options.h"
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class CodeGenerator;
+
+		// Writes each import header as soon as its library is decoded and then reduces the library to its
+		// summary, so at most one referenced library is held in memory at a time. Used by --low-memory and
+		// by the import benchmark with low_memory=1.
+		class LowMemoryImport
+		{
+		public:
+			static void Load(const std::string& typeLibraryFileName, const GeneratorOptions& options, CodeGenerator& generator, LoadLibraryResult& result);
+		};
+	}
+}
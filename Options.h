@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		struct GeneratorOptions
+		{
+			bool Implement = false;
+			bool BstrWrappers = false;
+			bool SafeArrayViews = false;
+			bool HresultWrappers = false;
+		};
+
+		struct Options
+		{
+			std::string TypeLibraryFileName;
+			GeneratorOptions Generator;
+			bool LowMemory = false;
+			std::string DiffOldFileName;
+			std::string DiffNewFileName;
+			bool EmitChanged = false;
+			std::string DependencyFileName;
+			std::string RecordFileName;
+			std::string ReplayFileName;
+			bool ReportStatistics = false;
+			std::string TraceFileName;
+			std::string AllocationsFileName;
+		};
+	}
+}
@@ -0,0 +1,81 @@
+#include "OutputFile.h"
+#include "FileLock.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		bool OutputFile::Write(const std::string& fileName, const std::string& content)
+		{
+			FileLock lock{ fileName };
+			if (IsCurrent(fileName, content))
+			{
+				// Make compares timestamps and has no restat, so an unchanged file must still look newer
+				// than the type library that was just rebuilt.
+				Touch(fileName);
+				return false;
+			}
+
+			auto temporaryFileName = GetTemporaryFileName(fileName);
+			{
+				std::ofstream out{ temporaryFileName.c_str() };
+				out << content;
+				out.close();
+				if (!out)
+				{
+					::DeleteFileA(temporaryFileName.c_str());
+					throw std::runtime_error("Unable to write output file: " + temporaryFileName);
+				}
+			}
+
+			if (!::MoveFileExA(temporaryFileName.c_str(), fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+			{
+				auto error = ::GetLastError();
+				::DeleteFileA(temporaryFileName.c_str());
+				throw std::runtime_error("Unable to replace output file: " + fileName + " (error " + std::to_string(error) + ")");
+			}
+			return true;
+		}
+
+		bool OutputFile::IsCurrent(const std::string& fileName, const std::string& content)
+		{
+			std::ifstream in{ fileName.c_str() };
+			if (!in)
+				return false;
+			std::string existing{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+			return existing == content;
+		}
+
+		void OutputFile::Touch(const std::string& fileName)
+		{
+			auto handle = ::CreateFileA(
+				fileName.c_str(),
+				FILE_WRITE_ATTRIBUTES,
+				FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				nullptr);
+			if (handle == INVALID_HANDLE_VALUE)
+			{
+				auto error = ::GetLastError();
+				throw std::runtime_error("Unable to open output file: " + fileName + " (error " + std::to_string(error) + ")");
+			}
+			FILETIME now;
+			::GetSystemTimeAsFileTime(&now);
+			auto touched = ::SetFileTime(handle, nullptr, nullptr, &now);
+			auto error = ::GetLastError();
+			::CloseHandle(handle);
+			if (!touched)
+				throw std::runtime_error("Unable to touch output file: " + fileName + " (error " + std::to_string(error) + ")");
+		}
+
+		std::string OutputFile::GetTemporaryFileName(const std::string& fileName)
+		{
+			return fileName + "." + std::to_string(::GetCurrentProcessId()) + ".tmp";
+		}
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class OutputFile
+		{
+		public:
+			static bool Write(const std::string& fileName, const std::string& content);
+
+		private:
+			static bool IsCurrent(const std::string& fileName, const std::string& content);
+			static void Touch(const std::string& fileName);
+			static std::string GetTemporaryFileName(const std::string& fileName);
+		};
+	}
+}
@@ -5,8 +5,8 @@ namespace Com
 {
 	namespace Import
 	{
-		ParameterFormatter::ParameterFormatter(const Parameter& value, ParameterFormat format)
-			: value(value), format(format)
+		ParameterFormatter::ParameterFormatter(const Parameter& value, ParameterFormat format, const GeneratorOptions& options)
+			: value(value), format(format), options(options)
 		{
 		}
 
@@ -26,6 +26,12 @@ namespace Com
 			case ParameterFormat::AsWrapperArgument:
 				WriteAsWrapperArgument(out);
 				break;
+			case ParameterFormat::AsViewWrapper:
+				WriteAsViewWrapper(out);
+				break;
+			case ParameterFormat::AsViewWrapperArgument:
+				WriteAsViewWrapperArgument(out);
+				break;
 			case ParameterFormat::AsCoclassReturnValue:
 				WriteAsCoclassReturnValue(out);
 				break;
@@ -70,6 +76,26 @@ namespace Com
 			out << "(" << value.Name << ")";
 		}
 
+		void ParameterFormatter::WriteAsViewWrapper(std::ostream& out) const
+		{
+			if (!IsView(value, options))
+				WriteAsWrapper(out);
+			else
+				out << (value.Out ? "" : "const ") << Format(value.Type, TypeFormat::AsView) << "& " << value.Name;
+		}
+
+		void ParameterFormatter::WriteAsViewWrapperArgument(std::ostream& out) const
+		{
+			if (!IsView(value, options))
+				WriteAsWrapperArgument(out);
+			else if (value.In && value.Out)
+				out << value.Name << ".Modify()";
+			else if (value.In)
+				out << value.Name << ".Get()";
+			else
+				out << value.Name << ".Receive()";
+		}
+
 		void ParameterFormatter::WriteAsCoclassReturnValue(std::ostream& out) const
 		{
 			if (value.Type.TypeEnum == TypeEnum::Int16)
@@ -97,9 +123,24 @@ namespace Com
 			}
 		}
 
-		ParameterFormatter Format(const Parameter& value, ParameterFormat format)
+		bool ParameterFormatter::IsView(const Parameter& value, const GeneratorOptions& options)
+		{
+			if (value.Type.IsArray || value.Type.Indirection != (value.Out ? 1 : 0))
+				return false;
+			switch (value.Type.TypeEnum)
+			{
+			case TypeEnum::String:
+				return options.BstrWrappers;
+			case TypeEnum::SafeArray:
+				return options.SafeArrayViews && value.Type.ElementType != TypeEnum::Empty;
+			default:
+				return false;
+			}
+		}
+
+		ParameterFormatter Format(const Parameter& value, ParameterFormat format, const GeneratorOptions& options)
 		{
-			return{ value, format };
+			return{ value, format, options };
 		}
 	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "DataTypes.h"
+#include "Options.h"
 #include <iostream>
 
 namespace Com
@@ -12,6 +13,8 @@ namespace Com
 			AsNative,
 			AsWrapper,
 			AsWrapperArgument,
+			AsViewWrapper,
+			AsViewWrapperArgument,
 			AsCoclassReturnValue,
 			AsCoclassArgument
 		};
@@ -21,22 +24,27 @@ namespace Com
 		private:
 			const Parameter& value;
 			ParameterFormat format;
+			GeneratorOptions options;
 
 		public:
-			ParameterFormatter(const Parameter& value, ParameterFormat format);
+			ParameterFormatter(const Parameter& value, ParameterFormat format, const GeneratorOptions& options);
 
 			std::ostream& Write(std::ostream& out) const;
 			friend std::ostream& operator<<(std::ostream& out, const ParameterFormatter& value);
 
+			static bool IsView(const Parameter& value, const GeneratorOptions& options);
+
 		private:
 			void WriteAsName(std::ostream& out) const;
 			void WriteAsNative(std::ostream& out) const;
 			void WriteAsWrapper(std::ostream& out) const;
 			void WriteAsWrapperArgument(std::ostream& out) const;
+			void WriteAsViewWrapper(std::ostream& out) const;
+			void WriteAsViewWrapperArgument(std::ostream& out) const;
 			void WriteAsCoclassReturnValue(std::ostream& out) const;
 			void WriteAsCoclassArgument(std::ostream& out) const;
 		};
 
-		ParameterFormatter Format(const Parameter& value, ParameterFormat format);
+		ParameterFormatter Format(const Parameter& value, ParameterFormat format, const GeneratorOptions& options = GeneratorOptions{});
 	}
 }
@@ -0,0 +1,100 @@
+#include "PerfectHash.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const unsigned int maximumSeed = 0xFFFF;
+
+			std::size_t RoundUpToPowerOfTwo(std::size_t value)
+			{
+				std::size_t result = 1;
+				while (result < value)
+					result <<= 1;
+				return result;
+			}
+		}
+
+		PerfectHash::PerfectHash(const std::vector<std::u16string>& keys)
+		{
+			if (keys.size() >= maximumSeed)
+				throw std::runtime_error("Too many keys for a perfect hash.");
+			auto slotCount = RoundUpToPowerOfTwo(keys.size());
+			while (!TryBuild(keys, slotCount))
+				slotCount <<= 1;
+		}
+
+		const std::vector<unsigned short>& PerfectHash::GetSeeds() const
+		{
+			return seeds;
+		}
+
+		const std::vector<unsigned short>& PerfectHash::GetSlots() const
+		{
+			return slots;
+		}
+
+		unsigned int PerfectHash::Hash(const std::u16string& key, unsigned int seed)
+		{
+			// FNV-1a over the ASCII case folded UTF-16 units; the generated lookup computes the same on wchar_t.
+			auto hash = 2166136261u ^ seed;
+			for (auto unit : key)
+			{
+				unsigned int folded = unit >= u'A' && unit <= u'Z' ? unit + (u'a' - u'A') : unit;
+				hash = (hash ^ folded) * 16777619u;
+			}
+			return hash;
+		}
+
+		bool PerfectHash::TryBuild(const std::vector<std::u16string>& keys, std::size_t slotCount)
+		{
+			// Hash and displace: keys are grouped into buckets by the unseeded hash, then the largest
+			// buckets pick the first seed that moves all of their keys into free slots.
+			auto bucketCount = RoundUpToPowerOfTwo(std::max<std::size_t>(keys.size() / 2, 1));
+			std::vector<std::vector<std::size_t>> buckets(bucketCount);
+			for (std::size_t index = 0; index < keys.size(); ++index)
+				buckets[Hash(keys[index], 0) & (bucketCount - 1)].push_back(index);
+			std::vector<std::size_t> order(bucketCount);
+			for (std::size_t index = 0; index < bucketCount; ++index)
+				order[index] = index;
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs)
+			{
+				return buckets[lhs].size() > buckets[rhs].size();
+			});
+
+			seeds.assign(bucketCount, 0);
+			slots.assign(slotCount, 0);
+			std::vector<std::size_t> candidate;
+			for (auto bucket : order)
+			{
+				if (buckets[bucket].empty())
+					break;
+				auto placed = false;
+				for (auto seed = 1u; !placed && seed <= maximumSeed; ++seed)
+				{
+					candidate.clear();
+					for (auto key : buckets[bucket])
+					{
+						auto slot = Hash(keys[key], seed) & (slotCount - 1);
+						if (slots[slot] != 0 || std::find(candidate.begin(), candidate.end(), slot) != candidate.end())
+							break;
+						candidate.push_back(slot);
+					}
+					if (candidate.size() != buckets[bucket].size())
+						continue;
+					for (std::size_t index = 0; index < candidate.size(); ++index)
+						slots[candidate[index]] = static_cast<unsigned short>(buckets[bucket][index] + 1);
+					seeds[bucket] = static_cast<unsigned short>(seed);
+					placed = true;
+				}
+				if (!placed)
+					return false;
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class PerfectHash
+		{
+		private:
+			std::vector<unsigned short> seeds;
+			std::vector<unsigned short> slots;
+
+		public:
+			PerfectHash(const std::vector<std::u16string>& keys);
+
+			const std::vector<unsigned short>& GetSeeds() const;
+			const std::vector<unsigned short>& GetSlots() const;
+
+			static unsigned int Hash(const std::u16string& key, unsigned int seed);
+
+		private:
+			bool TryBuild(const std::vector<std::u16string>& keys, std::size_t slotCount);
+		};
+	}
+}
@@ -0,0 +1,18 @@
+#include "ProcessInfo.h"
+#include <windows.h>
+#include <psapi.h>
+
+namespace Com
+{
+	namespace Import
+	{
+		std::size_t ProcessInfo::GetPeakWorkingSet()
+		{
+			PROCESS_MEMORY_COUNTERS counters{};
+			counters.cb = sizeof(counters);
+			if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+				return 0;
+			return counters.PeakWorkingSetSize;
+		}
+	}
+}
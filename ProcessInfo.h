@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+
+namespace Com
+{
+	namespace Import
+	{
+		class ProcessInfo
+		{
+		public:
+			static std::size_t GetPeakWorkingSet();
+		};
+	}
+}
@@ -0,0 +1,117 @@
+#include "RecordingTypeInfo.h"
+#include "TypeLibraryRecorder.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		RecordingTypeInfo::RecordingTypeInfo(TypeLibraryRecorder& recorder, const TypeReferenceTrace& reference, Pointer<ITypeInfo2> typeInfo)
+			: recorder(recorder), reference(reference), type(recorder.GetType(reference)), typeInfo(typeInfo)
+		{
+		}
+
+		HRESULT RecordingTypeInfo::GetTypeAttr(TYPEATTR** attributes)
+		{
+			return typeInfo->GetTypeAttr(attributes);
+		}
+
+		HRESULT RecordingTypeInfo::GetFuncDesc(UINT index, FUNCDESC** description)
+		{
+			auto hr = typeInfo->GetFuncDesc(index, description);
+			if (SUCCEEDED(hr) && type.Functions.find(index) == type.Functions.end())
+				type.Functions[index] = recorder.GetTrace().CopyFunction(**description);
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetVarDesc(UINT index, VARDESC** description)
+		{
+			auto hr = typeInfo->GetVarDesc(index, description);
+			if (SUCCEEDED(hr) && type.Variables.find(index) == type.Variables.end())
+				type.Variables[index] = recorder.GetTrace().CopyVariable(**description);
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetNames(MEMBERID member, BSTR* names, UINT maximum, UINT* count)
+		{
+			auto hr = typeInfo->GetNames(member, names, maximum, count);
+			if (FAILED(hr))
+				return hr;
+
+			auto& recorded = type.Names[member];
+			if (*count > recorded.size())
+			{
+				recorded.clear();
+				for (auto index = 0u; index < *count; ++index)
+					recorded.emplace_back(names[index], ::SysStringLen(names[index]));
+			}
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetRefTypeOfImplType(UINT index, HREFTYPE* handle)
+		{
+			auto hr = typeInfo->GetRefTypeOfImplType(index, handle);
+			if (SUCCEEDED(hr))
+				type.ImplementedTypes[index] = *handle;
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetDocumentation(MEMBERID member, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile)
+		{
+			auto hr = typeInfo->GetDocumentation(member, name, documentation, helpContext, helpFile);
+			if (SUCCEEDED(hr) && name != nullptr)
+				type.Documentation[member].assign(*name, ::SysStringLen(*name));
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetRefTypeInfo(HREFTYPE handle, ITypeInfo** typeInfo)
+		{
+			Pointer<ITypeInfo> result;
+			auto hr = this->typeInfo->GetRefTypeInfo(handle, &result);
+			if (FAILED(hr))
+				return hr;
+
+			TypeReferenceTrace reference{};
+			hr = recorder.WrapTypeInfo(result, reference, typeInfo);
+			if (SUCCEEDED(hr))
+				type.References[handle] = reference;
+			return hr;
+		}
+
+		HRESULT RecordingTypeInfo::GetContainingTypeLib(ITypeLib** library, UINT* index)
+		{
+			if (library != nullptr)
+			{
+				*library = recorder.GetLibrary(reference.Library);
+				(*library)->AddRef();
+			}
+			if (index != nullptr)
+				*index = reference.Type;
+			return S_OK;
+		}
+
+		void RecordingTypeInfo::ReleaseTypeAttr(TYPEATTR* attributes)
+		{
+			typeInfo->ReleaseTypeAttr(attributes);
+		}
+
+		void RecordingTypeInfo::ReleaseFuncDesc(FUNCDESC* description)
+		{
+			typeInfo->ReleaseFuncDesc(description);
+		}
+
+		void RecordingTypeInfo::ReleaseVarDesc(VARDESC* description)
+		{
+			typeInfo->ReleaseVarDesc(description);
+		}
+
+		HRESULT RecordingTypeInfo::GetTypeKind(TYPEKIND* typeKind)
+		{
+			return typeInfo->GetTypeKind(typeKind);
+		}
+
+		HRESULT RecordingTypeInfo::GetTypeFlags(ULONG* flags)
+		{
+			return typeInfo->GetTypeFlags(flags);
+		}
+	}
+}
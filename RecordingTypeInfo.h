@@ -0,0 +1,38 @@
+#pragma once
+#include "TypeInfoBase.h"
+#include "TypeLibraryTrace.h"
+#include <Com/Com.h>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryRecorder;
+
+		class RecordingTypeInfo : public TypeInfoBase
+		{
+		private:
+			TypeLibraryRecorder& recorder;
+			TypeReferenceTrace reference;
+			TypeTrace& type;
+			Pointer<ITypeInfo2> typeInfo;
+
+		public:
+			RecordingTypeInfo(TypeLibraryRecorder& recorder, const TypeReferenceTrace& reference, Pointer<ITypeInfo2> typeInfo);
+
+			HRESULT __stdcall GetTypeAttr(TYPEATTR** attributes) override;
+			HRESULT __stdcall GetFuncDesc(UINT index, FUNCDESC** description) override;
+			HRESULT __stdcall GetVarDesc(UINT index, VARDESC** description) override;
+			HRESULT __stdcall GetNames(MEMBERID member, BSTR* names, UINT maximum, UINT* count) override;
+			HRESULT __stdcall GetRefTypeOfImplType(UINT index, HREFTYPE* handle) override;
+			HRESULT __stdcall GetDocumentation(MEMBERID member, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+			HRESULT __stdcall GetRefTypeInfo(HREFTYPE handle, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetContainingTypeLib(ITypeLib** library, UINT* index) override;
+			void __stdcall ReleaseTypeAttr(TYPEATTR* attributes) override;
+			void __stdcall ReleaseFuncDesc(FUNCDESC* description) override;
+			void __stdcall ReleaseVarDesc(VARDESC* description) override;
+			HRESULT __stdcall GetTypeKind(TYPEKIND* typeKind) override;
+			HRESULT __stdcall GetTypeFlags(ULONG* flags) override;
+		};
+	}
+}
@@ -0,0 +1,42 @@
+#include "RecordingTypeLibrary.h"
+#include "TypeLibraryRecorder.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		RecordingTypeLibrary::RecordingTypeLibrary(TypeLibraryRecorder& recorder, UINT index, Pointer<ITypeLib> typeLibrary)
+			: recorder(recorder), index(index), typeLibrary(typeLibrary)
+		{
+		}
+
+		UINT RecordingTypeLibrary::GetTypeInfoCount()
+		{
+			return typeLibrary->GetTypeInfoCount();
+		}
+
+		HRESULT RecordingTypeLibrary::GetTypeInfo(UINT index, ITypeInfo** typeInfo)
+		{
+			Pointer<ITypeInfo> result;
+			auto hr = typeLibrary->GetTypeInfo(index, &result);
+			if (FAILED(hr))
+				return hr;
+			return recorder.WrapTypeInfo({ this->index, index }, result, typeInfo);
+		}
+
+		HRESULT RecordingTypeLibrary::GetLibAttr(TLIBATTR** attributes)
+		{
+			return typeLibrary->GetLibAttr(attributes);
+		}
+
+		HRESULT RecordingTypeLibrary::GetDocumentation(INT index, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile)
+		{
+			return typeLibrary->GetDocumentation(index, name, documentation, helpContext, helpFile);
+		}
+
+		void RecordingTypeLibrary::ReleaseTLibAttr(TLIBATTR* attributes)
+		{
+			typeLibrary->ReleaseTLibAttr(attributes);
+		}
+	}
+}
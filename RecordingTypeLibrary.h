@@ -0,0 +1,28 @@
+#pragma once
+#include "TypeLibraryBase.h"
+#include <Com/Com.h>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryRecorder;
+
+		class RecordingTypeLibrary : public TypeLibraryBase
+		{
+		private:
+			TypeLibraryRecorder& recorder;
+			UINT index;
+			Pointer<ITypeLib> typeLibrary;
+
+		public:
+			RecordingTypeLibrary(TypeLibraryRecorder& recorder, UINT index, Pointer<ITypeLib> typeLibrary);
+
+			UINT __stdcall GetTypeInfoCount() override;
+			HRESULT __stdcall GetTypeInfo(UINT index, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetLibAttr(TLIBATTR** attributes) override;
+			HRESULT __stdcall GetDocumentation(INT index, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+			void __stdcall ReleaseTLibAttr(TLIBATTR* attributes) override;
+		};
+	}
+}
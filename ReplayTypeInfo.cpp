@@ -0,0 +1,111 @@
+#include "ReplayTypeInfo.h"
+#include "TypeLibraryReplayer.h"
+#include <algorithm>
+
+namespace Com
+{
+	namespace Import
+	{
+		ReplayTypeInfo::ReplayTypeInfo(TypeLibraryReplayer& replayer, const TypeReferenceTrace& reference, TypeTrace& type)
+			: replayer(replayer), reference(reference), type(type)
+		{
+		}
+
+		HRESULT ReplayTypeInfo::GetTypeAttr(TYPEATTR** attributes)
+		{
+			*attributes = &type.Attributes;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetFuncDesc(UINT index, FUNCDESC** description)
+		{
+			auto found = type.Functions.find(index);
+			if (found == type.Functions.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			auto& function = found->second;
+			function.Description.lprgelemdescParam = function.Parameters.empty() ? nullptr : function.Parameters.data();
+			*description = &function.Description;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetVarDesc(UINT index, VARDESC** description)
+		{
+			auto found = type.Variables.find(index);
+			if (found == type.Variables.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			auto& variable = found->second;
+			if (variable.Description.varkind == VAR_CONST)
+				variable.Description.lpvarValue = &variable.Value;
+			*description = &variable.Description;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetNames(MEMBERID member, BSTR* names, UINT maximum, UINT* count)
+		{
+			auto found = type.Names.find(member);
+			if (found == type.Names.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			*count = std::min(maximum, static_cast<UINT>(found->second.size()));
+			for (auto index = 0u; index < *count; ++index)
+				names[index] = TypeLibraryReplayer::AllocateString(found->second[index]);
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetRefTypeOfImplType(UINT index, HREFTYPE* handle)
+		{
+			auto found = type.ImplementedTypes.find(index);
+			if (found == type.ImplementedTypes.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			*handle = found->second;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetDocumentation(MEMBERID member, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile)
+		{
+			auto found = type.Documentation.find(member);
+			if (found == type.Documentation.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			if (name != nullptr)
+				*name = TypeLibraryReplayer::AllocateString(found->second);
+			if (documentation != nullptr)
+				*documentation = nullptr;
+			if (helpContext != nullptr)
+				*helpContext = 0;
+			if (helpFile != nullptr)
+				*helpFile = nullptr;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetRefTypeInfo(HREFTYPE handle, ITypeInfo** typeInfo)
+		{
+			auto found = type.References.find(handle);
+			if (found == type.References.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			return replayer.CreateTypeInfo(found->second, typeInfo);
+		}
+
+		HRESULT ReplayTypeInfo::GetContainingTypeLib(ITypeLib** library, UINT* index)
+		{
+			if (library != nullptr)
+			{
+				*library = replayer.GetLibrary(reference.Library);
+				(*library)->AddRef();
+			}
+			if (index != nullptr)
+				*index = reference.Type;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetTypeKind(TYPEKIND* typeKind)
+		{
+			*typeKind = type.Attributes.typekind;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeInfo::GetTypeFlags(ULONG* flags)
+		{
+			*flags = type.Attributes.wTypeFlags;
+			return S_OK;
+		}
+	}
+}
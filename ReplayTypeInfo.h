@@ -0,0 +1,33 @@
+#pragma once
+#include "TypeInfoBase.h"
+#include "TypeLibraryTrace.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryReplayer;
+
+		class ReplayTypeInfo : public TypeInfoBase
+		{
+		private:
+			TypeLibraryReplayer& replayer;
+			TypeReferenceTrace reference;
+			TypeTrace& type;
+
+		public:
+			ReplayTypeInfo(TypeLibraryReplayer& replayer, const TypeReferenceTrace& reference, TypeTrace& type);
+
+			HRESULT __stdcall GetTypeAttr(TYPEATTR** attributes) override;
+			HRESULT __stdcall GetFuncDesc(UINT index, FUNCDESC** description) override;
+			HRESULT __stdcall GetVarDesc(UINT index, VARDESC** description) override;
+			HRESULT __stdcall GetNames(MEMBERID member, BSTR* names, UINT maximum, UINT* count) override;
+			HRESULT __stdcall GetRefTypeOfImplType(UINT index, HREFTYPE* handle) override;
+			HRESULT __stdcall GetDocumentation(MEMBERID member, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+			HRESULT __stdcall GetRefTypeInfo(HREFTYPE handle, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetContainingTypeLib(ITypeLib** library, UINT* index) override;
+			HRESULT __stdcall GetTypeKind(TYPEKIND* typeKind) override;
+			HRESULT __stdcall GetTypeFlags(ULONG* flags) override;
+		};
+	}
+}
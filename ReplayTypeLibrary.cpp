@@ -0,0 +1,44 @@
+#include "ReplayTypeLibrary.h"
+#include "TypeLibraryReplayer.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		ReplayTypeLibrary::ReplayTypeLibrary(TypeLibraryReplayer& replayer, UINT index, LibraryTrace& library)
+			: replayer(replayer), index(index), library(library)
+		{
+		}
+
+		UINT ReplayTypeLibrary::GetTypeInfoCount()
+		{
+			return library.TypeCount;
+		}
+
+		HRESULT ReplayTypeLibrary::GetTypeInfo(UINT index, ITypeInfo** typeInfo)
+		{
+			return replayer.CreateTypeInfo({ this->index, index }, typeInfo);
+		}
+
+		HRESULT ReplayTypeLibrary::GetLibAttr(TLIBATTR** attributes)
+		{
+			*attributes = &library.Attributes;
+			return S_OK;
+		}
+
+		HRESULT ReplayTypeLibrary::GetDocumentation(INT index, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile)
+		{
+			if (index != -1)
+				return TYPE_E_ELEMENTNOTFOUND;
+			if (name != nullptr)
+				*name = TypeLibraryReplayer::AllocateString(library.Name);
+			if (documentation != nullptr)
+				*documentation = nullptr;
+			if (helpContext != nullptr)
+				*helpContext = 0;
+			if (helpFile != nullptr)
+				*helpFile = nullptr;
+			return S_OK;
+		}
+	}
+}
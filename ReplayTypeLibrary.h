@@ -0,0 +1,27 @@
+#pragma once
+#include "TypeLibraryBase.h"
+#include "TypeLibraryTrace.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryReplayer;
+
+		class ReplayTypeLibrary : public TypeLibraryBase
+		{
+		private:
+			TypeLibraryReplayer& replayer;
+			UINT index;
+			LibraryTrace& library;
+
+		public:
+			ReplayTypeLibrary(TypeLibraryReplayer& replayer, UINT index, LibraryTrace& library);
+
+			UINT __stdcall GetTypeInfoCount() override;
+			HRESULT __stdcall GetTypeInfo(UINT index, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetLibAttr(TLIBATTR** attributes) override;
+			HRESULT __stdcall GetDocumentation(INT index, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+		};
+	}
+}
@@ -0,0 +1,180 @@
+#include "Statistics.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+#ifdef COM_IMPORT_STATISTICS
+void* operator new(std::size_t size)
+{
+	Com::Import::Statistics::CountAllocation(size);
+	Com::Import::AllocationTracker::CountAllocation(size);
+	auto result = std::malloc(size == 0 ? 1 : size);
+	if (result == nullptr)
+		throw std::bad_alloc();
+	return result;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+#endif
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			// The innermost running timer of this thread, whose self time excludes the phases nested in it.
+			thread_local Statistics::Timer* currentTimer = nullptr;
+		}
+
+		Statistics::Timer::Timer(std::string name)
+			: name(std::move(name)), start(), nested(std::chrono::steady_clock::duration::zero()), parent(nullptr), previousPhase(nullptr)
+		{
+			// An empty name means neither statistics nor allocation tracking is enabled; skip the clock.
+			if (this->name.empty())
+				return;
+			previousPhase = AllocationTracker::EnterPhase(&this->name);
+			if (enabled)
+			{
+				parent = currentTimer;
+				currentTimer = this;
+				start = std::chrono::steady_clock::now();
+			}
+		}
+
+		Statistics::Timer::~Timer()
+		{
+			if (name.empty())
+				return;
+			AllocationTracker::LeavePhase(previousPhase);
+			if (start != std::chrono::steady_clock::time_point{})
+			{
+				auto elapsed = std::chrono::steady_clock::now() - start;
+				currentTimer = parent;
+				if (parent != nullptr)
+					parent->nested += elapsed;
+				GetInstance().AddPhase(name, elapsed, elapsed - nested);
+			}
+		}
+
+		std::atomic<bool> Statistics::enabled{ false };
+		std::atomic<unsigned long long> Statistics::allocationCount{ 0 };
+		std::atomic<unsigned long long> Statistics::allocationBytes{ 0 };
+
+		void Statistics::Enable()
+		{
+			enabled = true;
+		}
+
+		bool Statistics::IsEnabled()
+		{
+			return enabled;
+		}
+
+		bool Statistics::IsAvailable()
+		{
+#ifdef COM_IMPORT_STATISTICS
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		void Statistics::CountCall(const char* method)
+		{
+			if (!enabled)
+				return;
+			auto& instance = GetInstance();
+			std::lock_guard<std::mutex> lock{ instance.mutex };
+			++instance.calls[method];
+		}
+
+		void Statistics::CountOutput(const std::string& fileName, std::size_t size)
+		{
+			if (!enabled)
+				return;
+			auto& instance = GetInstance();
+			std::lock_guard<std::mutex> lock{ instance.mutex };
+			instance.outputs.emplace_back(fileName, size);
+		}
+
+		void Statistics::CountAllocation(std::size_t size)
+		{
+			if (!enabled)
+				return;
+			++allocationCount;
+			allocationBytes += size;
+		}
+
+		void Statistics::Report(std::ostream& out)
+		{
+			auto& instance = GetInstance();
+			if (!IsAvailable())
+			{
+				out << "Statistics are not available; build with COM_IMPORT_STATISTICS defined." << std::endl;
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock{ instance.mutex };
+			std::size_t width = 0;
+			for (auto& name : instance.phaseOrder)
+				width = std::max(width, name.size());
+			for (auto& call : instance.calls)
+				width = std::max(width, call.first.size());
+			for (auto& output : instance.outputs)
+				width = std::max(width, output.first.size());
+
+			out << "Statistics:" << std::endl;
+			// Total time includes the phases nested in a phase; self time does not, so self times add up.
+			out << "  Phases:" << std::right << std::setw(width + 7) << "total"
+				<< std::setw(15) << "self" << std::endl;
+			for (auto& name : instance.phaseOrder)
+			{
+				auto& phase = instance.phases[name];
+				auto milliseconds = std::chrono::duration<double, std::milli>(phase.Elapsed).count();
+				auto selfMilliseconds = std::chrono::duration<double, std::milli>(phase.Self).count();
+				out << "    " << std::left << std::setw(width) << name
+					<< std::right << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds << " ms"
+					<< std::setw(12) << selfMilliseconds << " ms"
+					<< std::setw(10) << phase.Count << "x" << std::endl;
+			}
+			out << "  COM calls:" << std::endl;
+			for (auto& call : instance.calls)
+				out << "    " << std::left << std::setw(width) << call.first
+					<< std::right << std::setw(12) << call.second << std::endl;
+			out << "  Allocations:" << std::endl;
+			out << "    " << std::left << std::setw(width) << "count"
+				<< std::right << std::setw(12) << allocationCount.load() << std::endl;
+			out << "    " << std::left << std::setw(width) << "bytes"
+				<< std::right << std::setw(12) << allocationBytes.load() << std::endl;
+			out << "  Output bytes:" << std::endl;
+			for (auto& output : instance.outputs)
+				out << "    " << std::left << std::setw(width) << output.first
+					<< std::right << std::setw(12) << output.second << std::endl;
+		}
+
+		void Statistics::AddPhase(const std::string& name, std::chrono::steady_clock::duration elapsed, std::chrono::steady_clock::duration self)
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			auto found = phases.find(name);
+			if (found == phases.end())
+			{
+				phaseOrder.push_back(name);
+				found = phases.insert({ name, Phase{ std::chrono::steady_clock::duration::zero(), std::chrono::steady_clock::duration::zero(), 0 } }).first;
+			}
+			found->second.Elapsed += elapsed;
+			found->second.Self += self;
+			++found->second.Count;
+		}
+
+		Statistics& Statistics::GetInstance()
+		{
+			static Statistics instance;
+			return instance;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "AllocationTracker.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef COM_IMPORT_STATISTICS
+#define COM_IMPORT_STATISTICS_CONCAT_(lhs, rhs) lhs##rhs
+#define COM_IMPORT_STATISTICS_CONCAT(lhs, rhs) COM_IMPORT_STATISTICS_CONCAT_(lhs, rhs)
+#define COM_IMPORT_TIME_PHASE(name) \
+	::Com::Import::Statistics::Timer COM_IMPORT_STATISTICS_CONCAT(phaseTimer, __LINE__){ ::Com::Import::Statistics::IsEnabled() || ::Com::Import::AllocationTracker::IsEnabled() ? std::string{ name } : std::string{} }
+#define COM_IMPORT_COUNT_CALL(method) ::Com::Import::Statistics::CountCall(method)
+#define COM_IMPORT_COUNT_OUTPUT(fileName, size) ::Com::Import::Statistics::CountOutput(fileName, size)
+#else
+#define COM_IMPORT_TIME_PHASE(name) ((void)0)
+#define COM_IMPORT_COUNT_CALL(method) ((void)0)
+#define COM_IMPORT_COUNT_OUTPUT(fileName, size) ((void)0)
+#endif
+
+namespace Com
+{
+	namespace Import
+	{
+		class Statistics
+		{
+		public:
+			class Timer
+			{
+			private:
+				std::string name;
+				std::chrono::steady_clock::time_point start;
+				std::chrono::steady_clock::duration nested;
+				Timer* parent;
+				const std::string* previousPhase;
+
+			public:
+				Timer(std::string name);
+				Timer(const Timer& rhs) = delete;
+				~Timer();
+
+				Timer& operator=(const Timer& rhs) = delete;
+			};
+
+		private:
+			struct Phase
+			{
+				std::chrono::steady_clock::duration Elapsed;
+				std::chrono::steady_clock::duration Self;
+				unsigned long long Count;
+			};
+
+			static std::atomic<bool> enabled;
+			static std::atomic<unsigned long long> allocationCount;
+			static std::atomic<unsigned long long> allocationBytes;
+			std::mutex mutex;
+			std::vector<std::string> phaseOrder;
+			std::map<std::string, Phase> phases;
+			std::map<std::string, unsigned long long> calls;
+			std::vector<std::pair<std::string, std::size_t>> outputs;
+
+		public:
+			static void Enable();
+			static bool IsEnabled();
+			static bool IsAvailable();
+			static void CountCall(const char* method);
+			static void CountOutput(const std::string& fileName, std::size_t size);
+			static void CountAllocation(std::size_t size);
+			static void Report(std::ostream& out);
+
+		private:
+			Statistics() = default;
+
+			void AddPhase(const std::string& name, std::chrono::steady_clock::duration elapsed, std::chrono::steady_clock::duration self);
+			static Statistics& GetInstance();
+		};
+	}
+}
@@ -0,0 +1,892 @@
+#include "SupportFormatter.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			// Emitted once per translation unit; the guard lets several imported headers share it.
+			const char* const dispatchSupport = R"(#ifndef COM_IMPORT_DISPATCH_SUPPORT
+#define COM_IMPORT_DISPATCH_SUPPORT
+#include <chrono>
+#include <new>
+#include <string>
+#include <type_traits>
+namespace Com
+{
+	namespace Import
+	{
+		namespace Dispatch
+		{
+			class Value
+			{
+			private:
+				VARIANT value;
+
+			public:
+				Value()
+				{
+					::VariantInit(&value);
+				}
+				Value(const Value& rhs) = delete;
+				~Value()
+				{
+					::VariantClear(&value);
+				}
+				Value& operator=(const Value& rhs) = delete;
+				VARIANT* Get()
+				{
+					return &value;
+				}
+				const VARIANT& operator*() const
+				{
+					return value;
+				}
+			};
+
+			template <unsigned int Count>
+			class Arguments
+			{
+			private:
+				VARIANTARG values[Count];
+
+			public:
+				Arguments()
+				{
+					for (auto& value : values)
+						::VariantInit(&value);
+				}
+				Arguments(const Arguments& rhs) = delete;
+				~Arguments()
+				{
+					for (auto& value : values)
+						::VariantClear(&value);
+				}
+				Arguments& operator=(const Arguments& rhs) = delete;
+				VARIANTARG& operator[](unsigned int index)
+				{
+					// IDispatch::Invoke takes the arguments in reverse order.
+					return values[Count - 1 - index];
+				}
+				VARIANTARG* Get()
+				{
+					return values;
+				}
+			};
+
+			template <>
+			class Arguments<0>
+			{
+			public:
+				VARIANTARG* Get()
+				{
+					return nullptr;
+				}
+			};
+
+			template <typename Interface>
+			class PointerAccess : public Com::Pointer<Interface>
+			{
+			public:
+				static Interface* Get(const Com::Pointer<Interface>& value)
+				{
+					return value.*(&PointerAccess::p);
+				}
+			};
+
+			inline void Convert(const VARIANT& source, VARTYPE type, Value& target)
+			{
+				Com::CheckError(::VariantChangeType(target.Get(), &source, 0, type), __FUNCTION__, "VariantChangeType");
+			}
+
+			inline void PutInterface(VARIANT& target, IUnknown* value)
+			{
+				target.vt = VT_UNKNOWN;
+				target.punkVal = value;
+			}
+
+			inline void PutInterface(VARIANT& target, IDispatch* value)
+			{
+				target.vt = VT_DISPATCH;
+				target.pdispVal = value;
+			}
+
+			inline void Put(VARIANT& target, bool value) { target.vt = VT_BOOL; target.boolVal = value ? VARIANT_TRUE : VARIANT_FALSE; }
+			inline void Put(VARIANT& target, char value) { target.vt = VT_I1; target.cVal = value; }
+			inline void Put(VARIANT& target, short value) { target.vt = VT_I2; target.iVal = value; }
+			inline void Put(VARIANT& target, int value) { target.vt = VT_INT; target.intVal = value; }
+			inline void Put(VARIANT& target, long value) { target.vt = VT_I4; target.lVal = value; }
+			inline void Put(VARIANT& target, long long value) { target.vt = VT_I8; target.llVal = value; }
+			inline void Put(VARIANT& target, unsigned char value) { target.vt = VT_UI1; target.bVal = value; }
+			inline void Put(VARIANT& target, unsigned short value) { target.vt = VT_UI2; target.uiVal = value; }
+			inline void Put(VARIANT& target, unsigned int value) { target.vt = VT_UINT; target.uintVal = value; }
+			inline void Put(VARIANT& target, unsigned long value) { target.vt = VT_UI4; target.ulVal = value; }
+			inline void Put(VARIANT& target, unsigned long long value) { target.vt = VT_UI8; target.ullVal = value; }
+			inline void Put(VARIANT& target, float value) { target.vt = VT_R4; target.fltVal = value; }
+			inline void Put(VARIANT& target, double value) { target.vt = VT_R8; target.dblVal = value; }
+			inline void Put(VARIANT& target, CURRENCY value) { target.vt = VT_CY; target.cyVal = value; }
+			inline void Put(VARIANT& target, DECIMAL value) { target.decVal = value; target.vt = VT_DECIMAL; }
+
+			inline void Put(VARIANT& target, std::chrono::system_clock::time_point value)
+			{
+				// DATE counts days from 1899-12-30, which is 25569 days before the system clock epoch.
+				using Days = std::chrono::duration<double, std::ratio<86400>>;
+				target.vt = VT_DATE;
+				target.date = 25569.0 + std::chrono::duration_cast<Days>(value.time_since_epoch()).count();
+			}
+
+			inline void Put(VARIANT& target, const std::string& value)
+			{
+				auto length = ::MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), nullptr, 0);
+				auto text = ::SysAllocStringLen(nullptr, length);
+				if (text == nullptr)
+					throw std::bad_alloc();
+				::MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), text, length);
+				target.vt = VT_BSTR;
+				target.bstrVal = text;
+			}
+
+			inline void Put(VARIANT& target, const VARIANT& value)
+			{
+				Com::CheckError(::VariantCopy(&target, &value), __FUNCTION__, "VariantCopy");
+			}
+
+			inline void Put(VARIANT& target, SAFEARRAY* value)
+			{
+				VARTYPE type = VT_VARIANT;
+				if (value != nullptr)
+				{
+					Com::CheckError(::SafeArrayGetVartype(value, &type), __FUNCTION__, "SafeArrayGetVartype");
+					Com::CheckError(::SafeArrayCopy(value, &target.parray), __FUNCTION__, "SafeArrayCopy");
+				}
+				else
+					target.parray = nullptr;
+				target.vt = VT_ARRAY | type;
+			}
+
+			template <typename Enum>
+			inline typename std::enable_if<std::is_enum<Enum>::value>::type Put(VARIANT& target, Enum value)
+			{
+				target.vt = VT_I4;
+				target.lVal = static_cast<long>(value);
+			}
+
+			template <typename Interface>
+			inline void Put(VARIANT& target, const Com::Pointer<Interface>& value)
+			{
+				auto pointer = PointerAccess<Interface>::Get(value);
+				if (pointer != nullptr)
+					pointer->AddRef();
+				PutInterface(target, pointer);
+			}
+
+			inline void Get(const VARIANT& source, bool& target) { Value value; Convert(source, VT_BOOL, value); target = (*value).boolVal != VARIANT_FALSE; }
+			inline void Get(const VARIANT& source, char& target) { Value value; Convert(source, VT_I1, value); target = (*value).cVal; }
+			inline void Get(const VARIANT& source, short& target) { Value value; Convert(source, VT_I2, value); target = (*value).iVal; }
+			inline void Get(const VARIANT& source, int& target) { Value value; Convert(source, VT_INT, value); target = (*value).intVal; }
+			inline void Get(const VARIANT& source, long& target) { Value value; Convert(source, VT_I4, value); target = (*value).lVal; }
+			inline void Get(const VARIANT& source, long long& target) { Value value; Convert(source, VT_I8, value); target = (*value).llVal; }
+			inline void Get(const VARIANT& source, unsigned char& target) { Value value; Convert(source, VT_UI1, value); target = (*value).bVal; }
+			inline void Get(const VARIANT& source, unsigned short& target) { Value value; Convert(source, VT_UI2, value); target = (*value).uiVal; }
+			inline void Get(const VARIANT& source, unsigned int& target) { Value value; Convert(source, VT_UINT, value); target = (*value).uintVal; }
+			inline void Get(const VARIANT& source, unsigned long& target) { Value value; Convert(source, VT_UI4, value); target = (*value).ulVal; }
+			inline void Get(const VARIANT& source, unsigned long long& target) { Value value; Convert(source, VT_UI8, value); target = (*value).ullVal; }
+			inline void Get(const VARIANT& source, float& target) { Value value; Convert(source, VT_R4, value); target = (*value).fltVal; }
+			inline void Get(const VARIANT& source, double& target) { Value value; Convert(source, VT_R8, value); target = (*value).dblVal; }
+			inline void Get(const VARIANT& source, CURRENCY& target) { Value value; Convert(source, VT_CY, value); target = (*value).cyVal; }
+			inline void Get(const VARIANT& source, DECIMAL& target) { Value value; Convert(source, VT_DECIMAL, value); target = (*value).decVal; }
+
+			inline void Get(const VARIANT& source, std::chrono::system_clock::time_point& target)
+			{
+				using Days = std::chrono::duration<double, std::ratio<86400>>;
+				Value value;
+				Convert(source, VT_DATE, value);
+				target = std::chrono::system_clock::time_point{ std::chrono::duration_cast<std::chrono::system_clock::duration>(Days{ (*value).date - 25569.0 }) };
+			}
+
+			inline void Get(const VARIANT& source, std::string& target)
+			{
+				Value value;
+				Convert(source, VT_BSTR, value);
+				auto text = (*value).bstrVal;
+				auto length = static_cast<int>(::SysStringLen(text));
+				target.resize(::WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr));
+				if (!target.empty())
+					::WideCharToMultiByte(CP_UTF8, 0, text, length, &target[0], static_cast<int>(target.size()), nullptr, nullptr);
+			}
+
+			inline void Get(const VARIANT& source, VARIANT& target)
+			{
+				Com::CheckError(::VariantCopyInd(&target, &source), __FUNCTION__, "VariantCopyInd");
+			}
+
+			inline void Get(const VARIANT& source, SAFEARRAY*& target)
+			{
+				if ((source.vt & VT_ARRAY) == 0)
+					Com::CheckError(DISP_E_TYPEMISMATCH, __FUNCTION__, "SafeArrayCopy");
+				auto array = (source.vt & VT_BYREF) != 0 ? *source.pparray : source.parray;
+				Com::CheckError(::SafeArrayCopy(array, &target), __FUNCTION__, "SafeArrayCopy");
+			}
+
+			template <typename Enum>
+			inline typename std::enable_if<std::is_enum<Enum>::value>::type Get(const VARIANT& source, Enum& target)
+			{
+				Value value;
+				Convert(source, VT_I4, value);
+				target = static_cast<Enum>((*value).lVal);
+			}
+
+			template <typename Interface>
+			inline void Get(const VARIANT& source, Com::Pointer<Interface>& target)
+			{
+				Value value;
+				Convert(source, VT_UNKNOWN, value);
+				target = nullptr;
+				if ((*value).punkVal != nullptr)
+					Com::CheckError((*value).punkVal->QueryInterface(__uuidof(Interface), reinterpret_cast<void**>(&target)), __FUNCTION__, "QueryInterface");
+			}
+
+			class Reference
+			{
+			private:
+				VARIANT value;
+
+			public:
+				Reference()
+				{
+					::VariantInit(&value);
+				}
+				Reference(const Reference& rhs) = delete;
+				~Reference()
+				{
+					::VariantClear(&value);
+				}
+				Reference& operator=(const Reference& rhs) = delete;
+
+				template <typename Type>
+				void Bind(VARIANTARG& argument, const Type& initial, bool in)
+				{
+					// An [out] argument only needs the type; its initial value would be overwritten and leaked.
+					Put(value, in ? initial : Type{});
+					if (!in && value.vt == VT_BSTR)
+					{
+						::SysFreeString(value.bstrVal);
+						value.bstrVal = nullptr;
+					}
+					if (std::is_base_of<VARIANT, Type>::value)
+					{
+						argument.vt = VT_BYREF | VT_VARIANT;
+						argument.pvarVal = &value;
+					}
+					else
+					{
+						argument.vt = VT_BYREF | value.vt;
+						argument.byref = value.vt == VT_DECIMAL ? static_cast<void*>(&value.decVal) : static_cast<void*>(&value.llVal);
+					}
+				}
+
+				template <typename Type>
+				void Read(Type& target) const
+				{
+					Get(value, target);
+				}
+			};
+
+			inline HRESULT Invoke(IDispatch* dispatch, DISPID member, WORD flags, VARIANTARG* arguments, UINT count, VARIANT* result)
+			{
+				DISPID propertyPut = DISPID_PROPERTYPUT;
+				auto isPut = (flags & (DISPATCH_PROPERTYPUT | DISPATCH_PROPERTYPUTREF)) != 0;
+				DISPPARAMS parameters{ arguments, isPut ? &propertyPut : nullptr, count, isPut ? 1u : 0u };
+				EXCEPINFO exception{};
+				auto hr = dispatch->Invoke(member, IID_NULL, LOCALE_USER_DEFAULT, flags, &parameters, result, &exception, nullptr);
+				if (hr == DISP_E_EXCEPTION)
+				{
+					if (exception.pfnDeferredFillIn != nullptr)
+						exception.pfnDeferredFillIn(&exception);
+					if (FAILED(exception.scode))
+						hr = exception.scode;
+					::SysFreeString(exception.bstrSource);
+					::SysFreeString(exception.bstrDescription);
+					::SysFreeString(exception.bstrHelpFile);
+				}
+				return hr;
+			}
+		}
+	}
+}
+#endif
+)";
+
+			const char* const dispatchImplementationSupport = R"(#ifndef COM_IMPORT_DISPATCH_IMPLEMENTATION_SUPPORT
+#define COM_IMPORT_DISPATCH_IMPLEMENTATION_SUPPORT
+#include <cstddef>
+#include <cstring>
+namespace Com
+{
+	namespace Import
+	{
+		namespace Dispatch
+		{
+			struct Name
+			{
+				const wchar_t* Text;
+				DISPID Id;
+			};
+
+			inline unsigned int HashName(const wchar_t* name, unsigned int seed)
+			{
+				auto hash = 2166136261u ^ seed;
+				for (; *name != L'\0'; ++name)
+				{
+					auto unit = static_cast<unsigned int>(*name);
+					if (unit >= L'A' && unit <= L'Z')
+						unit += L'a' - L'A';
+					hash = (hash ^ unit) * 16777619u;
+				}
+				return hash;
+			}
+
+			inline bool EqualsName(const wchar_t* lhs, const wchar_t* rhs)
+			{
+				for (;; ++lhs, ++rhs)
+				{
+					auto left = static_cast<unsigned int>(*lhs);
+					auto right = static_cast<unsigned int>(*rhs);
+					if (left >= L'A' && left <= L'Z')
+						left += L'a' - L'A';
+					if (right >= L'A' && right <= L'Z')
+						right += L'a' - L'A';
+					if (left != right)
+						return false;
+					if (left == 0)
+						return true;
+				}
+			}
+
+			template <std::size_t NameCount, std::size_t SeedCount, std::size_t SlotCount>
+			inline bool TryFindName(
+				const Name (&names)[NameCount],
+				const unsigned short (&seeds)[SeedCount],
+				const unsigned short (&slots)[SlotCount],
+				LPOLESTR* requested,
+				UINT count,
+				DISPID* ids)
+			{
+				static_assert((SeedCount & (SeedCount - 1)) == 0 && (SlotCount & (SlotCount - 1)) == 0, "Tables must be powers of two.");
+				// Parameter names are left to the type information.
+				if (count != 1 || requested == nullptr || ids == nullptr)
+					return false;
+				auto seed = seeds[HashName(requested[0], 0) & (SeedCount - 1)];
+				auto slot = slots[HashName(requested[0], seed) & (SlotCount - 1)];
+				if (slot == 0 || !EqualsName(names[slot - 1].Text, requested[0]))
+					return false;
+				ids[0] = names[slot - 1].Id;
+				return true;
+			}
+
+			inline bool IsPositional(const DISPPARAMS* parameters, WORD flags)
+			{
+				if (parameters == nullptr)
+					return false;
+				if ((flags & (DISPATCH_PROPERTYPUT | DISPATCH_PROPERTYPUTREF)) != 0)
+					return parameters->cNamedArgs == 1 && parameters->rgdispidNamedArgs[0] == DISPID_PROPERTYPUT;
+				return parameters->cNamedArgs == 0;
+			}
+
+			inline std::size_t GetSize(VARTYPE type)
+			{
+				if ((type & VT_ARRAY) != 0)
+					return sizeof(SAFEARRAY*);
+				switch (type)
+				{
+				case VT_I1: case VT_UI1:
+					return 1;
+				case VT_I2: case VT_UI2: case VT_BOOL:
+					return 2;
+				case VT_I4: case VT_UI4: case VT_INT: case VT_UINT: case VT_R4: case VT_ERROR:
+					return 4;
+				case VT_I8: case VT_UI8: case VT_R8: case VT_CY: case VT_DATE:
+					return 8;
+				case VT_BSTR: case VT_UNKNOWN: case VT_DISPATCH:
+					return sizeof(void*);
+				case VT_DECIMAL:
+					return sizeof(DECIMAL);
+				}
+				Com::CheckError(DISP_E_BADVARTYPE, __FUNCTION__, "GetSize");
+				return 0;
+			}
+
+			inline void* GetData(VARIANT& value, VARTYPE type)
+			{
+				return type == VT_DECIMAL ? static_cast<void*>(&value.decVal) : static_cast<void*>(&value.llVal);
+			}
+
+			class Invocation
+			{
+			private:
+				DISPPARAMS* parameters;
+
+			public:
+				Invocation(DISPPARAMS* parameters)
+					: parameters(parameters)
+				{
+				}
+
+				template <typename Type>
+				void Read(UINT index, Type& target) const
+				{
+					Get(At(index), target);
+				}
+
+				template <typename Type>
+				void Write(UINT index, const Type& value) const
+				{
+					auto& argument = At(index);
+					if ((argument.vt & VT_BYREF) == 0)
+						return;
+					Value source;
+					Put(*source.Get(), value);
+					if (argument.vt == (VT_BYREF | VT_VARIANT))
+					{
+						Com::CheckError(::VariantCopy(argument.pvarVal, source.Get()), __FUNCTION__, "VariantCopy");
+						return;
+					}
+					auto type = static_cast<VARTYPE>(argument.vt & ~VT_BYREF);
+					auto size = GetSize(type);
+					Value converted;
+					Convert(*source, type, converted);
+					// Swap the new value into the caller's storage and let the old one be cleared with ours.
+					Value previous;
+					std::memcpy(GetData(*previous.Get(), type), argument.byref, size);
+					previous.Get()->vt = type;
+					std::memcpy(argument.byref, GetData(*converted.Get(), type), size);
+					converted.Get()->vt = VT_EMPTY;
+				}
+
+				template <typename Type>
+				void Return(VARIANT* result, const Type& value) const
+				{
+					if (result != nullptr)
+						Put(*result, value);
+				}
+
+			private:
+				VARIANTARG& At(UINT index) const
+				{
+					// IDispatch::Invoke passes the arguments in reverse order.
+					return parameters->rgvarg[parameters->cArgs - 1 - index];
+				}
+			};
+		}
+	}
+}
+#endif
+)";
+
+			const char* const interfaceTableSupport = R"(#ifndef COM_IMPORT_INTERFACE_TABLE_SUPPORT
+#define COM_IMPORT_INTERFACE_TABLE_SUPPORT
+#include <cstddef>
+#include <cstring>
+namespace Com
+{
+	namespace Import
+	{
+		namespace Interfaces
+		{
+			template <typename Object>
+			struct Entry
+			{
+				::GUID Iid;
+				IUnknown* (*Cast)(Object* object);
+			};
+
+			template <typename Interface, typename Path, typename Object>
+			inline IUnknown* Cast(Object* object)
+			{
+				return static_cast<Interface*>(static_cast<Path*>(object));
+			}
+
+			template <typename Object, std::size_t Count>
+			inline IUnknown* Find(const Entry<Object> (&entries)[Count], Object* object, REFIID iid)
+			{
+				std::size_t first = 0;
+				std::size_t last = Count;
+				while (first < last)
+				{
+					auto middle = first + (last - first) / 2;
+					auto order = std::memcmp(&entries[middle].Iid, &iid, sizeof(::GUID));
+					if (order == 0)
+						return entries[middle].Cast(object);
+					if (order < 0)
+						first = middle + 1;
+					else
+						last = middle;
+				}
+				return nullptr;
+			}
+		}
+	}
+}
+#endif
+)";
+
+			const char* const stringsSupport = R"(#ifndef COM_IMPORT_STRINGS_SUPPORT
+#define COM_IMPORT_STRINGS_SUPPORT
+#include <cwchar>
+#include <new>
+#include <string>
+#include <utility>
+namespace Com
+{
+	namespace Import
+	{
+		namespace Strings
+		{
+			class Bstr
+			{
+			private:
+				BSTR value = nullptr;
+
+			public:
+				Bstr() = default;
+				Bstr(const wchar_t* text)
+					: Bstr(text, text == nullptr ? 0 : static_cast<UINT>(std::wcslen(text)))
+				{
+				}
+				Bstr(const wchar_t* text, UINT length)
+					: value(::SysAllocStringLen(text, length))
+				{
+					if (value == nullptr)
+						throw std::bad_alloc{};
+				}
+				explicit Bstr(const std::wstring& text)
+					: Bstr(text.data(), static_cast<UINT>(text.size()))
+				{
+				}
+				Bstr(const Bstr& rhs) = delete;
+				Bstr(Bstr&& rhs)
+					: value(rhs.value)
+				{
+					rhs.value = nullptr;
+				}
+				~Bstr()
+				{
+					::SysFreeString(value);
+				}
+				Bstr& operator=(const Bstr& rhs) = delete;
+				Bstr& operator=(Bstr&& rhs)
+				{
+					std::swap(value, rhs.value);
+					return *this;
+				}
+				BSTR Get() const
+				{
+					return value;
+				}
+				BSTR* Receive()
+				{
+					::SysFreeString(value);
+					value = nullptr;
+					return &value;
+				}
+				BSTR* Modify()
+				{
+					return &value;
+				}
+				const wchar_t* GetData() const
+				{
+					return value == nullptr ? L"" : value;
+				}
+				UINT GetLength() const
+				{
+					return ::SysStringLen(value);
+				}
+				std::wstring ToString() const
+				{
+					return{ GetData(), GetLength() };
+				}
+			};
+		}
+	}
+}
+#endif
+)";
+
+			const char* const safeArraysSupport = R"(#ifndef COM_IMPORT_SAFEARRAYS_SUPPORT
+#define COM_IMPORT_SAFEARRAYS_SUPPORT
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+namespace Com
+{
+	namespace Import
+	{
+		namespace SafeArrays
+		{
+			template <typename Type> struct ElementType;
+			template <> struct ElementType<char> { static const VARTYPE Value = VT_I1; };
+			template <> struct ElementType<short> { static const VARTYPE Value = VT_I2; };
+			template <> struct ElementType<long> { static const VARTYPE Value = VT_I4; };
+			template <> struct ElementType<long long> { static const VARTYPE Value = VT_I8; };
+			template <> struct ElementType<int> { static const VARTYPE Value = VT_INT; };
+			template <> struct ElementType<unsigned char> { static const VARTYPE Value = VT_UI1; };
+			template <> struct ElementType<unsigned short> { static const VARTYPE Value = VT_UI2; };
+			template <> struct ElementType<unsigned long> { static const VARTYPE Value = VT_UI4; };
+			template <> struct ElementType<unsigned long long> { static const VARTYPE Value = VT_UI8; };
+			template <> struct ElementType<unsigned int> { static const VARTYPE Value = VT_UINT; };
+			template <> struct ElementType<float> { static const VARTYPE Value = VT_R4; };
+			template <> struct ElementType<double> { static const VARTYPE Value = VT_R8; };
+
+			template <typename Type>
+			class Span
+			{
+			private:
+				Type* data;
+				std::size_t size;
+
+			public:
+				Span(Type* data, std::size_t size)
+					: data(data), size(size)
+				{
+				}
+				Type* GetData() const
+				{
+					return data;
+				}
+				std::size_t GetSize() const
+				{
+					return size;
+				}
+				Type* begin() const
+				{
+					return data;
+				}
+				Type* end() const
+				{
+					return data + size;
+				}
+				Type& operator[](std::size_t index) const
+				{
+					return data[index];
+				}
+			};
+
+			template <typename Type>
+			class View
+			{
+			private:
+				SAFEARRAY* array = nullptr;
+				Type* data = nullptr;
+				std::size_t size = 0;
+
+			public:
+				explicit View(SAFEARRAY* value)
+				{
+					if (value == nullptr)
+						return;
+					VARTYPE type = VT_EMPTY;
+					Com::CheckError(::SafeArrayGetVartype(value, &type), __FUNCTION__, "SafeArrayGetVartype");
+					if (type != ElementType<Type>::Value || ::SafeArrayGetDim(value) != 1)
+						Com::CheckError(DISP_E_TYPEMISMATCH, __FUNCTION__, "SafeArrayGetVartype");
+					Com::CheckError(::SafeArrayAccessData(value, reinterpret_cast<void**>(&data)), __FUNCTION__, "SafeArrayAccessData");
+					array = value;
+					size = value->rgsabound[0].cElements;
+				}
+				View(const View& rhs) = delete;
+				View(View&& rhs)
+					: array(rhs.array), data(rhs.data), size(rhs.size)
+				{
+					rhs.array = nullptr;
+				}
+				~View()
+				{
+					if (array != nullptr)
+						::SafeArrayUnaccessData(array);
+				}
+				View& operator=(const View& rhs) = delete;
+				Span<Type> GetSpan() const
+				{
+					return{ data, size };
+				}
+			};
+
+			template <typename Type>
+			class SafeArray
+			{
+			private:
+				SAFEARRAY* value = nullptr;
+
+			public:
+				SafeArray() = default;
+				SafeArray(const Type* data, std::size_t size)
+					: value(::SafeArrayCreateVector(ElementType<Type>::Value, 0, static_cast<ULONG>(size)))
+				{
+					if (value == nullptr)
+						throw std::bad_alloc{};
+					if (size == 0)
+						return;
+					void* target = nullptr;
+					auto hr = ::SafeArrayAccessData(value, &target);
+					if (FAILED(hr))
+						::SafeArrayDestroy(value);
+					Com::CheckError(hr, __FUNCTION__, "SafeArrayAccessData");
+					std::memcpy(target, data, size * sizeof(Type));
+					::SafeArrayUnaccessData(value);
+				}
+				explicit SafeArray(Span<const Type> values)
+					: SafeArray(values.GetData(), values.GetSize())
+				{
+				}
+				explicit SafeArray(const std::vector<Type>& values)
+					: SafeArray(values.data(), values.size())
+				{
+				}
+				SafeArray(const SafeArray& rhs) = delete;
+				SafeArray(SafeArray&& rhs)
+					: value(rhs.value)
+				{
+					rhs.value = nullptr;
+				}
+				~SafeArray()
+				{
+					if (value != nullptr)
+						::SafeArrayDestroy(value);
+				}
+				SafeArray& operator=(const SafeArray& rhs) = delete;
+				SafeArray& operator=(SafeArray&& rhs)
+				{
+					std::swap(value, rhs.value);
+					return *this;
+				}
+				SAFEARRAY* Get() const
+				{
+					return value;
+				}
+				SAFEARRAY** Receive()
+				{
+					if (value != nullptr)
+						::SafeArrayDestroy(value);
+					value = nullptr;
+					return &value;
+				}
+				SAFEARRAY** Modify()
+				{
+					return &value;
+				}
+				View<Type> Access() const
+				{
+					return View<Type>{ value };
+				}
+			};
+		}
+	}
+}
+#endif
+)";
+
+			const char* const callsSupport = R"(#ifndef COM_IMPORT_CALLS_SUPPORT
+#define COM_IMPORT_CALLS_SUPPORT
+namespace Com
+{
+	namespace Import
+	{
+		namespace Calls
+		{
+			// Call is a tag such as CallTags::IFoo::BarCall, with static constexpr GetInterfaceName() and GetMethodName().
+			class NoPolicy
+			{
+			public:
+				template <typename Call>
+				static void Before()
+				{
+				}
+				template <typename Call>
+				static void After(HRESULT)
+				{
+				}
+			};
+		}
+	}
+}
+#ifndef COM_IMPORT_CALL_POLICY
+#define COM_IMPORT_CALL_POLICY Com::Import::Calls::NoPolicy
+#endif
+#endif
+)";
+		}
+
+		SupportFormatter::SupportFormatter(SupportFormat format)
+			: format(format)
+		{
+		}
+
+		std::ostream& SupportFormatter::Write(std::ostream& out) const
+		{
+			switch (format)
+			{
+			case SupportFormat::AsDispatch:
+				WriteAsDispatch(out);
+				break;
+			case SupportFormat::AsDispatchImplementation:
+				WriteAsDispatchImplementation(out);
+				break;
+			case SupportFormat::AsInterfaceTable:
+				WriteAsInterfaceTable(out);
+				break;
+			case SupportFormat::AsStrings:
+				WriteAsStrings(out);
+				break;
+			case SupportFormat::AsSafeArrays:
+				WriteAsSafeArrays(out);
+				break;
+			case SupportFormat::AsCalls:
+				WriteAsCalls(out);
+				break;
+			}
+			return out;
+		}
+
+		std::ostream& operator<<(std::ostream& out, const SupportFormatter& value)
+		{
+			return value.Write(out);
+		}
+
+		void SupportFormatter::WriteAsDispatch(std::ostream& out) const
+		{
+			out << dispatchSupport;
+		}
+
+		void SupportFormatter::WriteAsDispatchImplementation(std::ostream& out) const
+		{
+			out << dispatchImplementationSupport;
+		}
+
+		void SupportFormatter::WriteAsInterfaceTable(std::ostream& out) const
+		{
+			out << interfaceTableSupport;
+		}
+
+		void SupportFormatter::WriteAsStrings(std::ostream& out) const
+		{
+			out << stringsSupport;
+		}
+
+		void SupportFormatter::WriteAsSafeArrays(std::ostream& out) const
+		{
+			out << safeArraysSupport;
+		}
+
+		void SupportFormatter::WriteAsCalls(std::ostream& out) const
+		{
+			out << callsSupport;
+		}
+
+		SupportFormatter Format(SupportFormat format)
+		{
+			return{ format };
+		}
+	}
+}
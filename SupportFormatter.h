@@ -0,0 +1,40 @@
+#pragma once
+#include <iostream>
+
+namespace Com
+{
+	namespace Import
+	{
+		enum class SupportFormat
+		{
+			AsDispatch,
+			AsDispatchImplementation,
+			AsInterfaceTable,
+			AsStrings,
+			AsSafeArrays,
+			AsCalls
+		};
+
+		class SupportFormatter
+		{
+		private:
+			SupportFormat format;
+
+		public:
+			SupportFormatter(SupportFormat format);
+
+			std::ostream& Write(std::ostream& out) const;
+			friend std::ostream& operator<<(std::ostream& out, const SupportFormatter& value);
+
+		private:
+			void WriteAsDispatch(std::ostream& out) const;
+			void WriteAsDispatchImplementation(std::ostream& out) const;
+			void WriteAsInterfaceTable(std::ostream& out) const;
+			void WriteAsStrings(std::ostream& out) const;
+			void WriteAsSafeArrays(std::ostream& out) const;
+			void WriteAsCalls(std::ostream& out) const;
+		};
+
+		SupportFormatter Format(SupportFormat format);
+	}
+}
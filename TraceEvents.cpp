@@ -0,0 +1,103 @@
+#include "TraceEvents.h"
+#include "OutputFile.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace Com
+{
+	namespace Import
+	{
+		std::atomic<bool> TraceEvents::enabled{ false };
+
+		TraceEvents::Span::Span(const char* category, std::string name)
+			: category(category), name(std::move(name))
+		{
+			if (enabled)
+				start = std::chrono::steady_clock::now();
+		}
+
+		TraceEvents::Span::~Span()
+		{
+			if (enabled)
+				GetInstance().Add(category, std::move(name), start);
+		}
+
+		void TraceEvents::Enable()
+		{
+			GetInstance().origin = std::chrono::steady_clock::now();
+			enabled = true;
+		}
+
+		bool TraceEvents::IsEnabled()
+		{
+			return enabled;
+		}
+
+		void TraceEvents::Write(const std::string& fileName)
+		{
+			std::cout << "Generating trace: " << fileName << std::endl;
+			auto& instance = GetInstance();
+			std::lock_guard<std::mutex> lock{ instance.mutex };
+			auto processId = ::GetCurrentProcessId();
+			std::ostringstream out;
+			out << std::fixed << std::setprecision(3);
+			out << "{\"traceEvents\":[" << std::endl;
+			auto first = true;
+			for (auto& event : instance.events)
+			{
+				if (!first)
+					out << "," << std::endl;
+				first = false;
+				auto start = std::chrono::duration<double, std::micro>(event.Start - instance.origin).count();
+				auto duration = std::chrono::duration<double, std::micro>(event.Duration).count();
+				out << "{\"name\":";
+				WriteString(out, event.Name);
+				out << ",\"cat\":";
+				WriteString(out, event.Category);
+				out << ",\"ph\":\"X\",\"ts\":" << start
+					<< ",\"dur\":" << duration
+					<< ",\"pid\":" << processId
+					<< ",\"tid\":" << event.ThreadId << "}";
+			}
+			out << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+			OutputFile::Write(fileName, out.str());
+		}
+
+		void TraceEvents::Add(const char* category, std::string name, std::chrono::steady_clock::time_point start)
+		{
+			auto duration = std::chrono::steady_clock::now() - start;
+			auto threadId = ::GetCurrentThreadId();
+			std::lock_guard<std::mutex> lock{ mutex };
+			events.push_back({ category, std::move(name), start, duration, threadId });
+		}
+
+		void TraceEvents::WriteString(std::ostream& out, const std::string& value)
+		{
+			out << '"';
+			for (auto character : value)
+			{
+				switch (character)
+				{
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				case '\r': out << "\\r"; break;
+				case '\t': out << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(character) < 0x20)
+						out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec << std::setfill(' ');
+					else
+						out << character;
+				}
+			}
+			out << '"';
+		}
+
+		TraceEvents& TraceEvents::GetInstance()
+		{
+			static TraceEvents instance;
+			return instance;
+		}
+	}
+}
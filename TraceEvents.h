@@ -0,0 +1,60 @@
+#pragma once
+#include <objbase.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TraceEvents
+		{
+		public:
+			class Span
+			{
+			private:
+				const char* category;
+				std::string name;
+				std::chrono::steady_clock::time_point start;
+
+			public:
+				Span(const char* category, std::string name);
+				Span(const Span& rhs) = delete;
+				~Span();
+
+				Span& operator=(const Span& rhs) = delete;
+			};
+
+		private:
+			struct Event
+			{
+				const char* Category;
+				std::string Name;
+				std::chrono::steady_clock::time_point Start;
+				std::chrono::steady_clock::duration Duration;
+				DWORD ThreadId;
+			};
+
+			static std::atomic<bool> enabled;
+			std::chrono::steady_clock::time_point origin;
+			std::mutex mutex;
+			std::vector<Event> events;
+
+		public:
+			static void Enable();
+			static bool IsEnabled();
+			static void Write(const std::string& fileName);
+
+		private:
+			TraceEvents() = default;
+
+			void Add(const char* category, std::string name, std::chrono::steady_clock::time_point start);
+			static void WriteString(std::ostream& out, const std::string& value);
+			static TraceEvents& GetInstance();
+		};
+	}
+}
@@ -0,0 +1,304 @@
+#include "TraceSynthesizer.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const UINT primaryLibrary = 0;
+			const UINT sharedLibrary = 1;
+			const UINT valuesPerEnum = 4;
+			const UINT fieldsPerRecord = 4;
+			const MEMBERID firstFunction = 0x60020000;
+			const VARTYPE fieldTypes[] = { VT_I4, VT_BSTR, VT_R8, VT_BOOL };
+			// FUNCDESC::oVft and cParams are SHORTs; the last function's vtable offset must still fit.
+			const UINT maximumFunctions = (0x7FFF - 12) / 4 + 1;
+			const UINT maximumParameters = 0x7FFF;
+		}
+
+		const char* const TraceSynthesizer::FileName = "Synthetic.tlb";
+
+		const std::vector<std::string> TraceSynthesizer::SettingNames
+		{
+			"interfaces", "functions", "parameters", "records", "enums", "coclasses", "references", "libraries"
+		};
+
+		TraceSynthesizer::TraceSynthesizer(const BenchmarkSettings& settings)
+			: interfaces(settings.GetNumber("interfaces", 1000)),
+			functions(settings.GetNumber("functions", 10)),
+			parameters(settings.GetNumber("parameters", 3)),
+			records(settings.GetNumber("records", 100)),
+			enums(settings.GetNumber("enums", 100)),
+			coclasses(settings.GetNumber("coclasses", 100)),
+			references(settings.GetNumber("references", 10)),
+			libraries(std::max(1u, std::min(references, static_cast<UINT>(settings.GetNumber("libraries", 1)))))
+		{
+			if (functions > maximumFunctions)
+				throw std::runtime_error("Benchmark setting functions must be at most " + std::to_string(maximumFunctions) + ".");
+			if (parameters > maximumParameters)
+				throw std::runtime_error("Benchmark setting parameters must be at most " + std::to_string(maximumParameters) + ".");
+		}
+
+		TypeLibraryTrace TraceSynthesizer::Synthesize() const
+		{
+			TypeLibraryTrace trace;
+			auto& primary = AddLibrary(trace, primaryLibrary, L"Synthetic", FileName, GetTypeCount() - references);
+			for (auto index = 0u; index < enums; ++index)
+				AddEnum(trace, primary, index);
+			for (auto index = 0u; index < records; ++index)
+				AddRecord(trace, primary, index);
+			for (auto index = 0u; index < interfaces; ++index)
+				AddInterface(trace, primary, index);
+			for (auto index = 0u; index < coclasses; ++index)
+				AddCoclass(trace, primary, index);
+
+			// References are split into blocks over the shared libraries, SyntheticShared, SyntheticShared2, ...
+			for (auto library = 0u; library < GetSharedLibraryCount(); ++library)
+			{
+				auto suffix = library == 0 ? std::string{} : std::to_string(library + 1);
+				auto count = GetSharedTypeCount(library);
+				auto& shared = AddLibrary(trace, sharedLibrary + library,
+					L"SyntheticShared" + std::wstring(suffix.begin(), suffix.end()), "SyntheticShared" + suffix + ".tlb", count);
+				for (auto index = 0u; index < count; ++index)
+					AddSharedInterface(trace, shared, sharedLibrary + library, index);
+			}
+			return trace;
+		}
+
+		UINT TraceSynthesizer::GetTypeCount() const
+		{
+			return enums + records + interfaces + coclasses + references;
+		}
+
+		void TraceSynthesizer::WriteSettings(std::ostream& out) const
+		{
+			out << "  \"interfaces\": " << interfaces << "," << std::endl
+				<< "  \"functions\": " << functions << "," << std::endl
+				<< "  \"parameters\": " << parameters << "," << std::endl
+				<< "  \"records\": " << records << "," << std::endl
+				<< "  \"enums\": " << enums << "," << std::endl
+				<< "  \"coclasses\": " << coclasses << "," << std::endl
+				<< "  \"references\": " << references << "," << std::endl
+				<< "  \"libraries\": " << libraries << "," << std::endl;
+		}
+
+		UINT TraceSynthesizer::GetFirstRecord() const
+		{
+			return enums;
+		}
+
+		UINT TraceSynthesizer::GetFirstInterface() const
+		{
+			return enums + records;
+		}
+
+		UINT TraceSynthesizer::GetFirstCoclass() const
+		{
+			return enums + records + interfaces;
+		}
+
+		UINT TraceSynthesizer::GetReferencesPerLibrary() const
+		{
+			return (references + libraries - 1) / libraries;
+		}
+
+		UINT TraceSynthesizer::GetSharedLibraryCount() const
+		{
+			return references == 0 ? 0 : (references + GetReferencesPerLibrary() - 1) / GetReferencesPerLibrary();
+		}
+
+		UINT TraceSynthesizer::GetSharedTypeCount(UINT library) const
+		{
+			return std::min(GetReferencesPerLibrary(), references - library * GetReferencesPerLibrary());
+		}
+
+		void TraceSynthesizer::AddEnum(TypeLibraryTrace&, LibraryTrace& library, UINT index) const
+		{
+			auto& type = library.Types[index];
+			type.Attributes = CreateAttributes(TKIND_ENUM, primaryLibrary, index);
+			type.Attributes.cVars = valuesPerEnum;
+			type.Attributes.cbSizeInstance = 4;
+			type.Attributes.cbAlignment = 4;
+			auto name = L"Enum" + std::to_wstring(index);
+			type.Documentation[-1] = name;
+			for (auto value = 0u; value < valuesPerEnum; ++value)
+			{
+				VariableTrace variable{};
+				variable.Description.memid = static_cast<MEMBERID>(value);
+				variable.Description.varkind = VAR_CONST;
+				variable.Description.elemdescVar.tdesc.vt = VT_I4;
+				variable.Value.vt = VT_I4;
+				variable.Value.lVal = static_cast<LONG>(value);
+				type.Variables[value] = variable;
+				type.Names[variable.Description.memid] = { name + L"_Value" + std::to_wstring(value) };
+			}
+		}
+
+		void TraceSynthesizer::AddRecord(TypeLibraryTrace&, LibraryTrace& library, UINT index) const
+		{
+			auto typeIndex = GetFirstRecord() + index;
+			auto& type = library.Types[typeIndex];
+			type.Attributes = CreateAttributes(TKIND_RECORD, primaryLibrary, typeIndex);
+			type.Attributes.cVars = fieldsPerRecord;
+			type.Attributes.cbSizeInstance = fieldsPerRecord * 8;
+			type.Attributes.cbAlignment = 8;
+			type.Documentation[-1] = L"Record" + std::to_wstring(index);
+			for (auto field = 0u; field < fieldsPerRecord; ++field)
+			{
+				VariableTrace variable{};
+				variable.Description.memid = static_cast<MEMBERID>(0x40000000 + field);
+				variable.Description.varkind = VAR_PERINSTANCE;
+				variable.Description.oInst = field * 8;
+				variable.Description.elemdescVar.tdesc.vt = fieldTypes[field % 4];
+				type.Variables[field] = variable;
+				type.Names[variable.Description.memid] = { L"Field" + std::to_wstring(field) };
+			}
+		}
+
+		void TraceSynthesizer::AddInterface(TypeLibraryTrace& trace, LibraryTrace& library, UINT index) const
+		{
+			auto typeIndex = GetFirstInterface() + index;
+			auto& type = library.Types[typeIndex];
+			type.Attributes = CreateAttributes(TKIND_INTERFACE, primaryLibrary, typeIndex);
+			type.Attributes.cFuncs = static_cast<WORD>(functions);
+			type.Attributes.cbSizeVft = static_cast<WORD>(12 + 4 * functions);
+			type.Attributes.cbSizeInstance = 4;
+			type.Attributes.cbAlignment = 4;
+			type.Documentation[-1] = L"IInterface" + std::to_wstring(index);
+			for (auto function = 0u; function < functions; ++function)
+			{
+				auto value = CreateFunction(function, parameters);
+				for (auto parameter = 0u; parameter < parameters; ++parameter)
+					value.Parameters.push_back(CreateParameter(trace, type, index + function + parameter));
+				auto memid = value.Description.memid;
+				auto name = L"Method" + std::to_wstring(function);
+				type.Documentation[memid] = name;
+				auto& names = type.Names[memid];
+				names.push_back(name);
+				for (auto parameter = 0u; parameter < parameters; ++parameter)
+					names.push_back(L"value" + std::to_wstring(parameter));
+				type.Functions[function] = std::move(value);
+			}
+		}
+
+		void TraceSynthesizer::AddCoclass(TypeLibraryTrace&, LibraryTrace& library, UINT index) const
+		{
+			auto typeIndex = GetFirstCoclass() + index;
+			auto& type = library.Types[typeIndex];
+			type.Attributes = CreateAttributes(TKIND_COCLASS, primaryLibrary, typeIndex);
+			type.Attributes.wTypeFlags = TYPEFLAG_FCANCREATE;
+			type.Documentation[-1] = L"Class" + std::to_wstring(index);
+			if (interfaces == 0)
+				return;
+			type.Attributes.cImplTypes = 1;
+			type.ImplementedTypes[0] = AddReference(type, primaryLibrary, GetFirstInterface() + index % interfaces);
+		}
+
+		void TraceSynthesizer::AddSharedInterface(TypeLibraryTrace&, LibraryTrace& library, UINT libraryIndex, UINT index) const
+		{
+			auto& type = library.Types[index];
+			type.Attributes = CreateAttributes(TKIND_INTERFACE, libraryIndex, index);
+			type.Attributes.cFuncs = 1;
+			type.Attributes.cbSizeVft = 16;
+			type.Attributes.cbSizeInstance = 4;
+			type.Attributes.cbAlignment = 4;
+			type.Documentation[-1] = L"IShared" + std::to_wstring((libraryIndex - sharedLibrary) * GetReferencesPerLibrary() + index);
+			auto value = CreateFunction(0, 0);
+			type.Documentation[value.Description.memid] = L"Method0";
+			type.Names[value.Description.memid] = { L"Method0" };
+			type.Functions[0] = std::move(value);
+		}
+
+		ELEMDESC TraceSynthesizer::CreateParameter(TypeLibraryTrace& trace, TypeTrace& type, UINT index) const
+		{
+			ELEMDESC result{};
+			result.paramdesc.wParamFlags = PARAMFLAG_FIN;
+			switch (index % 6)
+			{
+			case 4:
+				if (enums > 0)
+				{
+					result.tdesc.vt = VT_USERDEFINED;
+					result.tdesc.hreftype = AddReference(type, primaryLibrary, index % enums);
+					return result;
+				}
+				break;
+			case 5:
+				if (references > 0 || interfaces > 0)
+				{
+					// Successive reference parameters take turns between the shared libraries.
+					auto library = references > 0 ? index / 6 % GetSharedLibraryCount() : 0;
+					TYPEDESC pointee{};
+					pointee.vt = VT_USERDEFINED;
+					pointee.hreftype = references > 0 ?
+						AddReference(type, sharedLibrary + library, index % GetSharedTypeCount(library)) :
+						AddReference(type, primaryLibrary, GetFirstInterface() + index % interfaces);
+					TYPEDESC pointer{};
+					pointer.vt = VT_PTR;
+					pointer.lptdesc = &pointee;
+					result.tdesc = trace.CopyType(pointer);
+					return result;
+				}
+				break;
+			default:
+				result.tdesc.vt = fieldTypes[index % 6];
+				return result;
+			}
+			result.tdesc.vt = VT_I4;
+			return result;
+		}
+
+		FunctionTrace TraceSynthesizer::CreateFunction(UINT index, UINT parameterCount)
+		{
+			FunctionTrace result{};
+			result.Description.memid = firstFunction + static_cast<MEMBERID>(index);
+			result.Description.funckind = FUNC_PUREVIRTUAL;
+			result.Description.invkind = INVOKE_FUNC;
+			result.Description.callconv = CC_STDCALL;
+			result.Description.cParams = static_cast<SHORT>(parameterCount);
+			result.Description.oVft = static_cast<SHORT>(12 + 4 * index);
+			result.Description.elemdescFunc.tdesc.vt = VT_HRESULT;
+			return result;
+		}
+
+		LibraryTrace& TraceSynthesizer::AddLibrary(TypeLibraryTrace& trace, UINT library, const std::wstring& name, const std::string& fileName, UINT typeCount)
+		{
+			TLIBATTR attributes{};
+			attributes.guid = CreateGuid(library, 0xFFFFFFFF);
+			attributes.syskind = SYS_WIN32;
+			attributes.wMajorVerNum = 1;
+			auto& result = trace.AddLibrary(attributes, typeCount);
+			result.Name = name;
+			result.FileNames.push_back(fileName);
+			result.Path.assign(fileName.begin(), fileName.end());
+			return result;
+		}
+
+		TYPEATTR TraceSynthesizer::CreateAttributes(TYPEKIND typeKind, UINT library, UINT index)
+		{
+			TYPEATTR result{};
+			result.guid = CreateGuid(library, index);
+			result.memidConstructor = -1;
+			result.memidDestructor = -1;
+			result.typekind = typeKind;
+			result.wMajorVerNum = 1;
+			return result;
+		}
+
+		GUID TraceSynthesizer::CreateGuid(UINT library, UINT index)
+		{
+			GUID result{ index, static_cast<unsigned short>(library), 0x5EED, { 0x8B, 0x3A, 0x00, 0xC0, 0x4F, 0x00, 0x00, 0x01 } };
+			return result;
+		}
+
+		HREFTYPE TraceSynthesizer::AddReference(TypeTrace& type, UINT library, UINT index)
+		{
+			auto handle = static_cast<HREFTYPE>((type.References.size() + 1) * 4);
+			type.References[handle] = { library, index };
+			return handle;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "BenchmarkSettings.h"
+#include "TypeLibraryTrace.h"
+#include <ostream>
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TraceSynthesizer
+		{
+		private:
+			UINT interfaces;
+			UINT functions;
+			UINT parameters;
+			UINT records;
+			UINT enums;
+			UINT coclasses;
+			UINT references;
+			UINT libraries;
+
+		public:
+			static const char* const FileName;
+			static const std::vector<std::string> SettingNames;
+
+			TraceSynthesizer(const BenchmarkSettings& settings);
+
+			TypeLibraryTrace Synthesize() const;
+			UINT GetTypeCount() const;
+			void WriteSettings(std::ostream& out) const;
+
+		private:
+			UINT GetFirstRecord() const;
+			UINT GetFirstInterface() const;
+			UINT GetFirstCoclass() const;
+			UINT GetReferencesPerLibrary() const;
+			UINT GetSharedLibraryCount() const;
+			UINT GetSharedTypeCount(UINT library) const;
+
+			void AddEnum(TypeLibraryTrace& trace, LibraryTrace& library, UINT index) const;
+			void AddRecord(TypeLibraryTrace& trace, LibraryTrace& library, UINT index) const;
+			void AddInterface(TypeLibraryTrace& trace, LibraryTrace& library, UINT index) const;
+			void AddCoclass(TypeLibraryTrace& trace, LibraryTrace& library, UINT index) const;
+			void AddSharedInterface(TypeLibraryTrace& trace, LibraryTrace& library, UINT libraryIndex, UINT index) const;
+			ELEMDESC CreateParameter(TypeLibraryTrace& trace, TypeTrace& type, UINT index) const;
+			static FunctionTrace CreateFunction(UINT index, UINT parameterCount);
+			static LibraryTrace& AddLibrary(TypeLibraryTrace& trace, UINT library, const std::wstring& name, const std::string& fileName, UINT typeCount);
+			static TYPEATTR CreateAttributes(TYPEKIND typeKind, UINT library, UINT index);
+			static GUID CreateGuid(UINT library, UINT index);
+			static HREFTYPE AddReference(TypeTrace& type, UINT library, UINT index);
+		};
+	}
+}
@@ -0,0 +1,134 @@
+#include "TranscodingBenchmark.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <chrono>
+#include <codecvt>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			struct Method
+			{
+				const char* Name;
+				std::function<std::size_t(const std::wstring&, std::string&)> Convert;
+			};
+
+			std::vector<std::wstring> CreateNames(unsigned long count, unsigned long length, unsigned long nonAsciiPerThousand)
+			{
+				const wchar_t alphabet[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_";
+				const wchar_t nonAscii[] = { 0x00E4, 0x00DF, 0x0416, 0x4E2D };
+				std::mt19937 random{ 0x5EED };
+				std::uniform_int_distribution<unsigned long> lengths{ std::max(1ul, length / 2), std::max(1ul, length * 3 / 2) };
+				std::uniform_int_distribution<std::size_t> letters{ 0, sizeof(alphabet) / sizeof(alphabet[0]) - 2 };
+				std::uniform_int_distribution<unsigned long> perThousand{ 0, 999 };
+
+				std::vector<std::wstring> names;
+				names.reserve(count);
+				for (auto index = 0ul; index < count; ++index)
+				{
+					std::wstring name(lengths(random), L' ');
+					for (auto& character : name)
+						character = alphabet[letters(random)];
+					if (perThousand(random) < nonAsciiPerThousand)
+						name[random() % name.size()] = nonAscii[random() % 4];
+					names.push_back(std::move(name));
+				}
+				return names;
+			}
+
+			std::vector<Method> CreateMethods()
+			{
+				return
+				{
+					{ "wstring_convert", [](const std::wstring& name, std::string& result)
+					{
+						result = std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(name);
+						return result.size();
+					} },
+					{ "scalar", [](const std::wstring& name, std::string& result)
+					{
+						result.resize(Utf8::GetMaximumLength(name.size()));
+						result.resize(Utf8::ConvertScalar(name.data(), name.size(), &result[0]));
+						return result.size();
+					} },
+					{ "simd", [](const std::wstring& name, std::string& result)
+					{
+						result.resize(Utf8::GetMaximumLength(name.size()));
+						result.resize(Utf8::Convert(name.data(), name.size(), &result[0]));
+						return result.size();
+					} },
+					{ "to_string", [](const std::wstring& name, std::string& result)
+					{
+						result = Utf8::ToString(name.data(), name.size());
+						return result.size();
+					} }
+				};
+			}
+		}
+
+		void TranscodingBenchmark::Run(const BenchmarkSettings& settings, std::ostream& out)
+		{
+			settings.CheckNames({ "names", "length", "non_ascii", "iterations" });
+			auto count = settings.GetNumber("names", 100000);
+			auto length = settings.GetNumber("length", 16);
+			auto nonAscii = settings.GetNumber("non_ascii", 5);
+			auto iterations = std::max(1ul, settings.GetNumber("iterations", 5));
+			auto names = CreateNames(count, length, nonAscii);
+			auto methods = CreateMethods();
+
+			std::string expected;
+			std::string actual;
+			for (auto& name : names)
+			{
+				methods.front().Convert(name, expected);
+				for (auto& method : methods)
+					if (method.Convert(name, actual) != expected.size() || actual != expected)
+						throw std::runtime_error(std::string{ "Transcoding method " } + method.Name + " disagrees with wstring_convert.");
+			}
+
+			out << "{" << std::endl
+				<< "  \"benchmark\": \"transcoding\"," << std::endl
+				<< "  \"names\": " << count << "," << std::endl
+				<< "  \"length\": " << length << "," << std::endl
+				<< "  \"non_ascii\": " << nonAscii << "," << std::endl
+				<< "  \"iterations\": " << iterations << "," << std::endl
+				<< "  \"methods\": [";
+			auto first = true;
+			for (auto& method : methods)
+			{
+				auto best = std::numeric_limits<double>::max();
+				std::size_t bytes = 0;
+				for (auto iteration = 0ul; iteration < iterations; ++iteration)
+				{
+					std::string result;
+					bytes = 0;
+					auto start = std::chrono::steady_clock::now();
+					for (auto& name : names)
+						bytes += method.Convert(name, result);
+					auto finish = std::chrono::steady_clock::now();
+					best = std::min(best, std::chrono::duration<double>(finish - start).count());
+				}
+
+				out << (first ? "" : ",") << std::endl
+					<< "    { \"method\": \"" << method.Name << "\""
+					<< ", \"bytes\": " << bytes
+					<< ", \"seconds\": " << best
+					<< ", \"ns_per_name\": " << (count > 0 ? best * 1e9 / count : 0)
+					<< ", \"bytes_per_second\": " << (best > 0 ? bytes / best : 0) << " }";
+				first = false;
+			}
+			out << std::endl
+				<< "  ]" << std::endl
+				<< "}" << std::endl;
+		}
+	}
+}
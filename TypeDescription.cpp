@@ -1,6 +1,8 @@
 #include "TypeDescription.h"
 #include "Loader.h"
 #include "TypeInfo.h"
+#include "Statistics.h"
+#include "Utf8.h"
 
 namespace Com
 {
@@ -26,8 +28,10 @@ namespace Com
 				return ToArrayType(*typeDescription.lpadesc, indirection);
 			case VT_USERDEFINED:
 				return ToUserDefinedType(typeDescription.hreftype, indirection);
+			case VT_SAFEARRAY:
+				return{ indirection, TypeEnum::SafeArray, "", false, 0, ToSafeArrayElementTypeEnum(*typeDescription.lptdesc) };
 			}
-			return{ indirection, ToBasicTypeEnum(typeDescription.vt), "", false, 0 };
+			return{ indirection, ToBasicTypeEnum(typeDescription.vt), "", false, 0, TypeEnum::Empty };
 		}
 
 		Type TypeDescription::ToArrayType(const ARRAYDESC& arrayDescription, int indirection) const
@@ -42,7 +46,7 @@ namespace Com
 			if (bounds.cElements == 0)
 				throw std::runtime_error("VT_CARRAY does not support empty arrays.");
 			auto typeEnum = ToArrayTypeEnum(arrayDescription.tdescElem.vt);
-			return{ 0, typeEnum, "", true, bounds.cElements };
+			return{ 0, typeEnum, "", true, bounds.cElements, TypeEnum::Empty };
 		}
 
 		TypeEnum TypeDescription::ToArrayTypeEnum(VARTYPE vt)
@@ -63,6 +67,26 @@ namespace Com
 			throw std::runtime_error("VT_CARRAY unsupported type.");
 		}
 
+		TypeEnum TypeDescription::ToSafeArrayElementTypeEnum(const TYPEDESC& elementDescription)
+		{
+			switch (elementDescription.vt)
+			{
+			case VT_INT: return TypeEnum::Int;
+			case VT_I1: return TypeEnum::Int8;
+			case VT_I2: return TypeEnum::Int16;
+			case VT_I4: return TypeEnum::Int32;
+			case VT_I8: return TypeEnum::Int64;
+			case VT_UINT: return TypeEnum::UInt;
+			case VT_UI1: return TypeEnum::UInt8;
+			case VT_UI2: return TypeEnum::UInt16;
+			case VT_UI4: return TypeEnum::UInt32;
+			case VT_UI8: return TypeEnum::UInt64;
+			case VT_R4: return TypeEnum::Float;
+			case VT_R8: return TypeEnum::Double;
+			}
+			return TypeEnum::Empty;
+		}
+
 		TypeEnum TypeDescription::ToBasicTypeEnum(VARTYPE vt)
 		{
 			if ((vt & VT_BYREF) == VT_BYREF)
@@ -108,6 +132,7 @@ namespace Com
 		Type TypeDescription::ToUserDefinedType(HREFTYPE handle, int indirection) const
 		{
 			Pointer<ITypeInfo> customType;
+			COM_IMPORT_COUNT_CALL("GetRefTypeInfo");
 			auto hr = typeInfo->GetRefTypeInfo(handle, &customType);
 			CheckError(hr, __FUNCTION__, "GetRefTypeInfo");
 
@@ -115,38 +140,40 @@ namespace Com
 			switch (GetTypeKind(customType))
 			{
 			case TKIND_ENUM:
-				return{ indirection, TypeEnum::Enum, customName, false, 0 };
+				return{ indirection, TypeEnum::Enum, customName, false, 0, TypeEnum::Empty };
 			case TKIND_ALIAS:
 				if (customName == "vsIndentStyle" ||
 					customName == "OLE_COLOR" ||
 					customName == "MsoRGBType")
-					return{ indirection, TypeEnum::Enum, customName, false, 0 };
-				return{ indirection, TypeEnum::Interface, customName, false, 0 };
+					return{ indirection, TypeEnum::Enum, customName, false, 0, TypeEnum::Empty };
+				return{ indirection, TypeEnum::Interface, customName, false, 0, TypeEnum::Empty };
 			case TKIND_INTERFACE:
 			case TKIND_DISPATCH:
-				return{ indirection, TypeEnum::Interface, customName, false, 0 };
+				return{ indirection, TypeEnum::Interface, customName, false, 0, TypeEnum::Empty };
 			case TKIND_RECORD:
-				return{ indirection, TypeEnum::Record, customName, false, 0 };
+				return{ indirection, TypeEnum::Record, customName, false, 0, TypeEnum::Empty };
 			case TKIND_COCLASS:
-				return{ indirection, TypeEnum::Interface, GetDefaultInterfaceName(customType), false, 0 };
+				return{ indirection, TypeEnum::Interface, GetDefaultInterfaceName(customType), false, 0, TypeEnum::Empty };
 			}
 			throw std::runtime_error("Unsupported user defined type TYPEKIND.");
 		}
 
 		std::string TypeDescription::GetUserDefinedTypeName(Pointer<ITypeInfo> customType) const
 		{
-			std::string customName;
-			auto hr = customType->GetDocumentation(-1, Get(customName), nullptr, nullptr, nullptr);
+			COM_IMPORT_ALLOCATION_SITE("TypeDescription::GetUserDefinedTypeName");
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			auto hr = customType->GetDocumentation(-1, text, nullptr, nullptr, nullptr);
 			CheckError(hr, __FUNCTION__, "GetDocumentation");
+			auto customName = text.ToString();
 
 			Pointer<ITypeLib> customLibrary;
 			UINT customIndex = 0;
+			COM_IMPORT_COUNT_CALL("GetContainingTypeLib");
 			hr = customType->GetContainingTypeLib(&customLibrary, &customIndex);
 			CheckError(hr, __FUNCTION__, "GetContainingTypeLib");
 
-			std::string customLibraryName;
-			hr = customLibrary->GetDocumentation(-1, Get(customLibraryName), nullptr, nullptr, nullptr);
-			CheckError(hr, __FUNCTION__, "customLibrary->GetDocumentation");
+			auto& customLibraryName = Loader::Identify(customLibrary).Name;
 
 			if (customLibraryName == libraryName)
 				return customName;
@@ -174,9 +201,11 @@ namespace Com
 		TYPEKIND TypeDescription::GetTypeKind(Pointer<ITypeInfo> customType)
 		{
 			TYPEATTR* attributes = nullptr;
+			COM_IMPORT_COUNT_CALL("GetTypeAttr");
 			auto hr = customType->GetTypeAttr(&attributes);
 			CheckError(hr, __FUNCTION__, "GetTypeAttr");
 			auto typeKind = attributes->typekind;
+			COM_IMPORT_COUNT_CALL("ReleaseTypeAttr");
 			customType->ReleaseTypeAttr(attributes);
 			return typeKind;
 		}
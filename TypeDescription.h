@@ -26,6 +26,7 @@ namespace Com
 			Type DetermineType(const TYPEDESC& typeDescription, int indirection) const;
 			Type ToArrayType(const ARRAYDESC& arrayDescription, int indirection) const;
 			static TypeEnum ToArrayTypeEnum(VARTYPE vt);
+			static TypeEnum ToSafeArrayElementTypeEnum(const TYPEDESC& elementDescription);
 			static TypeEnum ToBasicTypeEnum(VARTYPE vt);
 			Type ToUserDefinedType(HREFTYPE handle, int indirection) const;
 			std::string GetUserDefinedTypeName(Pointer<ITypeInfo> customType) const;
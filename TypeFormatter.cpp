@@ -1,4 +1,5 @@
 #include "TypeFormatter.h"
+#include "AllocationTracker.h"
 #include <stdexcept>
 #include <set>
 #include <string>
@@ -28,6 +29,9 @@ namespace Com
 			case TypeFormat::AsInitializer:
 				WriteAsInitializer(out);
 				break;
+			case TypeFormat::AsView:
+				WriteAsView(out);
+				break;
 			}
 			return out;
 		}
@@ -150,8 +154,24 @@ namespace Com
 			}
 		}
 
+		void TypeFormatter::WriteAsView(std::ostream& out) const
+		{
+			switch (value.TypeEnum)
+			{
+			case TypeEnum::String:
+				out << "Com::Import::Strings::Bstr";
+				break;
+			case TypeEnum::SafeArray:
+				out << "Com::Import::SafeArrays::SafeArray<" << Format(Type{ 0, value.ElementType, "", false, 0, TypeEnum::Empty }, TypeFormat::AsWrapper) << ">";
+				break;
+			default:
+				throw std::runtime_error("Type has no view.");
+			}
+		}
+
 		std::string TypeFormatter::GetSmartPointer() const
 		{
+			COM_IMPORT_ALLOCATION_SITE("TypeFormatter::GetSmartPointer");
 			std::set<std::string> standardInterfaces
 			{
 				"IUnknown",
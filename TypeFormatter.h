@@ -11,7 +11,8 @@ namespace Com
 			AsNative,
 			AsWrapper,
 			AsSuffix,
-			AsInitializer
+			AsInitializer,
+			AsView
 		};
 
 		class TypeFormatter
@@ -31,6 +32,7 @@ namespace Com
 			void WriteAsWrapper(std::ostream& out) const;
 			void WriteAsSuffix(std::ostream& out) const;
 			void WriteAsInitializer(std::ostream& out) const;
+			void WriteAsView(std::ostream& out) const;
 
 			std::string GetSmartPointer() const;
 		};
@@ -2,6 +2,8 @@
 #include "VariableDescription.h"
 #include "FunctionDescription.h"
 #include "Loader.h"
+#include "Statistics.h"
+#include "Utf8.h"
 #include <algorithm>
 #include <map>
 
@@ -11,18 +13,22 @@ namespace Com
 	{
 		TypeInfo::TypeInfo(Pointer<ITypeInfo> value)
 		{
+			COM_IMPORT_COUNT_CALL("QueryInterface");
 			auto hr = value->QueryInterface(&typeInfo);
 			CheckError(hr, __FUNCTION__, "QueryInterface");
+			COM_IMPORT_COUNT_CALL("GetTypeAttr");
 			hr = typeInfo->GetTypeAttr(&attributes);
 			CheckError(hr, __FUNCTION__, "GetTypeAttr");
-			hr = GetLibrary()->GetDocumentation(-1, Get(libraryName), nullptr, nullptr, nullptr);
-			CheckError(hr, __FUNCTION__, "GetDocumentation");
+			libraryName = Loader::Identify(GetLibrary()).Name;
 		}
 
 		TypeInfo::~TypeInfo()
 		{
 			if (attributes != nullptr)
+			{
+				COM_IMPORT_COUNT_CALL("ReleaseTypeAttr");
 				typeInfo->ReleaseTypeAttr(attributes);
+			}
 		}
 
 		const GUID& TypeInfo::GetId() const
@@ -32,10 +38,12 @@ namespace Com
 
 		std::string TypeInfo::GetName() const
 		{
-			std::string name;
-			auto hr = typeInfo->GetDocumentation(-1, Get(name), nullptr, nullptr, nullptr);
+			COM_IMPORT_ALLOCATION_SITE("TypeInfo::GetName");
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			auto hr = typeInfo->GetDocumentation(-1, text, nullptr, nullptr, nullptr);
 			CheckError(hr, __FUNCTION__, "GetDocumentation");
-			return name;
+			return text.ToString();
 		}
 
 		const std::string& TypeInfo::GetLibraryName() const
@@ -47,6 +55,7 @@ namespace Com
 		{
 			Pointer<ITypeLib> library;
 			UINT index = 0;
+			COM_IMPORT_COUNT_CALL("GetContainingTypeLib");
 			auto hr = typeInfo->GetContainingTypeLib(&library, &index);
 			CheckError(hr, __FUNCTION__, "GetContainingTypeLib");
 			return library;
@@ -55,6 +64,7 @@ namespace Com
 		TYPEKIND TypeInfo::GetTypeKind() const
 		{
 			TYPEKIND typeKind;
+			COM_IMPORT_COUNT_CALL("GetTypeKind");
 			auto hr = typeInfo->GetTypeKind(&typeKind);
 			CheckError(hr, __FUNCTION__, "GeTypeKind");
 			return typeKind;
@@ -62,6 +72,7 @@ namespace Com
 
 		Enum TypeInfo::ToEnum() const
 		{
+			COM_IMPORT_TIME_PHASE("decode enum");
 			Enum result{ GetName(),{} };
 			for (auto index = 0u; index < attributes->cVars; ++index)
 				result.Values.push_back(VariableDescription{ libraryName, typeInfo, index }.ToEnumValue());
@@ -70,6 +81,7 @@ namespace Com
 
 		Alias TypeInfo::ToAlias() const
 		{
+			COM_IMPORT_TIME_PHASE("decode alias");
 			switch (attributes->tdescAlias.vt)
 			{
 			case VT_I4:
@@ -83,22 +95,23 @@ namespace Com
 			}
 
 			Pointer<ITypeInfo> originalType;
+			COM_IMPORT_COUNT_CALL("GetRefTypeInfo");
 			auto hr = typeInfo->GetRefTypeInfo(attributes->tdescAlias.hreftype, &originalType);
 			CheckError(hr, __FUNCTION__, "typeInfo->GetRefTypeInfo");
 
-			std::string originalName;
-			hr = originalType->GetDocumentation(-1, Get(originalName), nullptr, nullptr, nullptr);
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			hr = originalType->GetDocumentation(-1, text, nullptr, nullptr, nullptr);
 			CheckError(hr, __FUNCTION__, "originalType->GetDocumentation");
+			auto originalName = text.ToString();
 
 			Pointer<ITypeLib> originalLibrary;
 			UINT index = 0;
+			COM_IMPORT_COUNT_CALL("GetContainingTypeLib");
 			hr = originalType->GetContainingTypeLib(&originalLibrary, &index);
 			CheckError(hr, __FUNCTION__, "originalType->GetContainingTypeLib");
 
-			std::string originalLibraryName;
-			hr = originalLibrary->GetDocumentation(-1, Get(originalLibraryName), nullptr, nullptr, nullptr);
-			CheckError(hr, __FUNCTION__, "originalLibrary->GetDocumentation");
-
+			auto& originalLibraryName = Loader::Identify(originalLibrary).Name;
 			if (libraryName != originalLibraryName)
 			{
 				Loader::AddReference(originalLibrary);
@@ -109,6 +122,7 @@ namespace Com
 
 		Coclass TypeInfo::ToCoclass() const
 		{
+			COM_IMPORT_TIME_PHASE("decode coclass");
 			std::map<std::string, int> countByFunction;
 			Coclass result{ GetName(), GetId(),{} };
 			for (auto index = 0u; index < attributes->cImplTypes; ++index)
@@ -128,10 +142,12 @@ namespace Com
 		Interface TypeInfo::GetInterface(UINT index) const
 		{
 			HREFTYPE referenceHandle = 0;
+			COM_IMPORT_COUNT_CALL("GetRefTypeOfImplType");
 			auto hr = typeInfo->GetRefTypeOfImplType(index, &referenceHandle);
 			CheckError(hr, __FUNCTION__, "GetRefTypeOfImplType");
 
 			Pointer<ITypeInfo> referenceType;
+			COM_IMPORT_COUNT_CALL("GetRefTypeInfo");
 			hr = typeInfo->GetRefTypeInfo(referenceHandle, &referenceType);
 			CheckError(hr, __FUNCTION__, "GetRefTypeInfo");
 
@@ -145,25 +161,28 @@ namespace Com
 		std::string TypeInfo::GetInterfaceName(UINT index) const
 		{
 			HREFTYPE referenceHandle = 0;
+			COM_IMPORT_COUNT_CALL("GetRefTypeOfImplType");
 			auto hr = typeInfo->GetRefTypeOfImplType(index, &referenceHandle);
 			CheckError(hr, __FUNCTION__, "GetRefTypeOfImplType");
 
 			Pointer<ITypeInfo> referenceType;
+			COM_IMPORT_COUNT_CALL("GetRefTypeInfo");
 			hr = typeInfo->GetRefTypeInfo(referenceHandle, &referenceType);
 			CheckError(hr, __FUNCTION__, "GetRefTypeInfo");
 
-			std::string name;
-			hr = referenceType->GetDocumentation(-1, Get(name), nullptr, nullptr, nullptr);
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			hr = referenceType->GetDocumentation(-1, text, nullptr, nullptr, nullptr);
 			CheckError(hr, __FUNCTION__, "GetDocumentation");
+			auto name = text.ToString();
 
 			Pointer<ITypeLib> referenceLibrary;
 			UINT referenceIndex = 0;
+			COM_IMPORT_COUNT_CALL("GetContainingTypeLib");
 			hr = referenceType->GetContainingTypeLib(&referenceLibrary, &referenceIndex);
 			CheckError(hr, __FUNCTION__, "GetContainingTypeLib");
 
-			std::string referenceLibraryName;
-			hr = referenceLibrary->GetDocumentation(-1, Get(referenceLibraryName), nullptr, nullptr, nullptr);
-			CheckError(hr, __FUNCTION__, "referenceTypeLibrary->GetDocumentation");
+			auto& referenceLibraryName = Loader::Identify(referenceLibrary).Name;
 			if (referenceLibraryName == libraryName)
 				return name;
 
@@ -180,6 +199,7 @@ namespace Com
 
 		Record TypeInfo::ToRecord() const
 		{
+			COM_IMPORT_TIME_PHASE("decode record");
 			Record result{ GetName(), GetId(), attributes->cbAlignment,{} };
 			for (auto index = 0u; index < attributes->cVars; ++index)
 				result.Members.push_back(VariableDescription{ libraryName, typeInfo, index }.ToParameter());
@@ -188,6 +208,7 @@ namespace Com
 
 		Interface TypeInfo::ToInterface() const
 		{
+			COM_IMPORT_TIME_PHASE("decode interface");
 			Interface result{ GetId(), "IID_", GetName(), "IUnknown", IID_IUnknown, false, 12, {}, false };
 			if (GetTypeKind() == TKIND_DISPATCH)
 			{
@@ -196,6 +217,7 @@ namespace Com
 				result.SupportsDispatch = true;
 				result.VtblOffset += 16;
 				ULONG flags = 0;
+				COM_IMPORT_COUNT_CALL("GetTypeFlags");
 				auto hr = typeInfo->GetTypeFlags(&flags);
 				CheckError(hr, __FUNCTION__, "GetTypeFlags");
 				if ((flags & TYPEFLAG_FDUAL) != TYPEFLAG_FDUAL)
@@ -212,10 +234,12 @@ namespace Com
 		void TypeInfo::TryUpdateBaseInterface(Interface& value) const
 		{
 			HREFTYPE baseHandle = 0;
+			COM_IMPORT_COUNT_CALL("GetRefTypeOfImplType");
 			auto hr = typeInfo->GetRefTypeOfImplType(0, &baseHandle);
 			CheckError(hr, __FUNCTION__, "GetRefTypeOfImplType");
 
 			Pointer<ITypeInfo> baseType;
+			COM_IMPORT_COUNT_CALL("GetRefTypeInfo");
 			hr = typeInfo->GetRefTypeInfo(baseHandle, &baseType);
 			CheckError(hr, __FUNCTION__, "GetRefTyepInfo");
 
@@ -0,0 +1,201 @@
+#include "TypeInfoBase.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		HRESULT TypeInfoBase::QueryInterface(REFIID riid, void** ppvObject)
+		{
+			if (ppvObject == nullptr)
+				return E_POINTER;
+			if (riid != IID_IUnknown && riid != IID_ITypeInfo && riid != IID_ITypeInfo2)
+			{
+				*ppvObject = nullptr;
+				return E_NOINTERFACE;
+			}
+			*ppvObject = static_cast<ITypeInfo2*>(this);
+			AddRef();
+			return S_OK;
+		}
+
+		ULONG TypeInfoBase::AddRef()
+		{
+			return ::InterlockedIncrement(&references);
+		}
+
+		ULONG TypeInfoBase::Release()
+		{
+			auto result = ::InterlockedDecrement(&references);
+			if (result == 0)
+				delete this;
+			return result;
+		}
+
+		HRESULT TypeInfoBase::GetTypeAttr(TYPEATTR**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetTypeComp(ITypeComp**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetFuncDesc(UINT, FUNCDESC**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetVarDesc(UINT, VARDESC**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetNames(MEMBERID, BSTR*, UINT, UINT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetRefTypeOfImplType(UINT, HREFTYPE*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetImplTypeFlags(UINT, INT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetIDsOfNames(LPOLESTR*, UINT, MEMBERID*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::Invoke(PVOID, MEMBERID, WORD, DISPPARAMS*, VARIANT*, EXCEPINFO*, UINT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetDocumentation(MEMBERID, BSTR*, BSTR*, DWORD*, BSTR*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetDllEntry(MEMBERID, INVOKEKIND, BSTR*, BSTR*, WORD*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetRefTypeInfo(HREFTYPE, ITypeInfo**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::AddressOfMember(MEMBERID, INVOKEKIND, PVOID*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::CreateInstance(IUnknown*, REFIID, PVOID*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetMops(MEMBERID, BSTR*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetContainingTypeLib(ITypeLib**, UINT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		void TypeInfoBase::ReleaseTypeAttr(TYPEATTR*)
+		{
+		}
+
+		void TypeInfoBase::ReleaseFuncDesc(FUNCDESC*)
+		{
+		}
+
+		void TypeInfoBase::ReleaseVarDesc(VARDESC*)
+		{
+		}
+
+		HRESULT TypeInfoBase::GetTypeKind(TYPEKIND*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetTypeFlags(ULONG*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetFuncIndexOfMemId(MEMBERID, INVOKEKIND, UINT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetVarIndexOfMemId(MEMBERID, UINT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetCustData(REFGUID, VARIANT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetFuncCustData(UINT, REFGUID, VARIANT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetParamCustData(UINT, UINT, REFGUID, VARIANT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetVarCustData(UINT, REFGUID, VARIANT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetImplTypeCustData(UINT, REFGUID, VARIANT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetDocumentation2(MEMBERID, LCID, BSTR*, DWORD*, BSTR*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetAllCustData(CUSTDATA*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetAllFuncCustData(UINT, CUSTDATA*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetAllParamCustData(UINT, UINT, CUSTDATA*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetAllVarCustData(UINT, CUSTDATA*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeInfoBase::GetAllImplTypeCustData(UINT, CUSTDATA*)
+		{
+			return E_NOTIMPL;
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <objbase.h>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeInfoBase : public ITypeInfo2
+		{
+		private:
+			long references = 1;
+
+		public:
+			TypeInfoBase() = default;
+			TypeInfoBase(const TypeInfoBase& rhs) = delete;
+			virtual ~TypeInfoBase() = default;
+
+			TypeInfoBase& operator=(const TypeInfoBase& rhs) = delete;
+
+			HRESULT __stdcall QueryInterface(REFIID riid, void** ppvObject) override;
+			ULONG __stdcall AddRef() override;
+			ULONG __stdcall Release() override;
+
+			HRESULT __stdcall GetTypeAttr(TYPEATTR** attributes) override;
+			HRESULT __stdcall GetTypeComp(ITypeComp** typeComp) override;
+			HRESULT __stdcall GetFuncDesc(UINT index, FUNCDESC** description) override;
+			HRESULT __stdcall GetVarDesc(UINT index, VARDESC** description) override;
+			HRESULT __stdcall GetNames(MEMBERID member, BSTR* names, UINT maximum, UINT* count) override;
+			HRESULT __stdcall GetRefTypeOfImplType(UINT index, HREFTYPE* handle) override;
+			HRESULT __stdcall GetImplTypeFlags(UINT index, INT* flags) override;
+			HRESULT __stdcall GetIDsOfNames(LPOLESTR* names, UINT count, MEMBERID* members) override;
+			HRESULT __stdcall Invoke(PVOID instance, MEMBERID member, WORD flags, DISPPARAMS* parameters, VARIANT* result, EXCEPINFO* exception, UINT* argumentError) override;
+			HRESULT __stdcall GetDocumentation(MEMBERID member, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+			HRESULT __stdcall GetDllEntry(MEMBERID member, INVOKEKIND invokeKind, BSTR* dllName, BSTR* name, WORD* ordinal) override;
+			HRESULT __stdcall GetRefTypeInfo(HREFTYPE handle, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall AddressOfMember(MEMBERID member, INVOKEKIND invokeKind, PVOID* address) override;
+			HRESULT __stdcall CreateInstance(IUnknown* outer, REFIID riid, PVOID* ppvObject) override;
+			HRESULT __stdcall GetMops(MEMBERID member, BSTR* mops) override;
+			HRESULT __stdcall GetContainingTypeLib(ITypeLib** library, UINT* index) override;
+			void __stdcall ReleaseTypeAttr(TYPEATTR* attributes) override;
+			void __stdcall ReleaseFuncDesc(FUNCDESC* description) override;
+			void __stdcall ReleaseVarDesc(VARDESC* description) override;
+
+			HRESULT __stdcall GetTypeKind(TYPEKIND* typeKind) override;
+			HRESULT __stdcall GetTypeFlags(ULONG* flags) override;
+			HRESULT __stdcall GetFuncIndexOfMemId(MEMBERID member, INVOKEKIND invokeKind, UINT* index) override;
+			HRESULT __stdcall GetVarIndexOfMemId(MEMBERID member, UINT* index) override;
+			HRESULT __stdcall GetCustData(REFGUID guid, VARIANT* value) override;
+			HRESULT __stdcall GetFuncCustData(UINT index, REFGUID guid, VARIANT* value) override;
+			HRESULT __stdcall GetParamCustData(UINT function, UINT parameter, REFGUID guid, VARIANT* value) override;
+			HRESULT __stdcall GetVarCustData(UINT index, REFGUID guid, VARIANT* value) override;
+			HRESULT __stdcall GetImplTypeCustData(UINT index, REFGUID guid, VARIANT* value) override;
+			HRESULT __stdcall GetDocumentation2(MEMBERID member, LCID lcid, BSTR* helpString, DWORD* helpContext, BSTR* helpFile) override;
+			HRESULT __stdcall GetAllCustData(CUSTDATA* values) override;
+			HRESULT __stdcall GetAllFuncCustData(UINT index, CUSTDATA* values) override;
+			HRESULT __stdcall GetAllParamCustData(UINT function, UINT parameter, CUSTDATA* values) override;
+			HRESULT __stdcall GetAllVarCustData(UINT index, CUSTDATA* values) override;
+			HRESULT __stdcall GetAllImplTypeCustData(UINT index, CUSTDATA* values) override;
+		};
+	}
+}
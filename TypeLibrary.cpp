@@ -1,4 +1,7 @@
 #include "TypeLibrary.h"
+#include "TypeLibrarySource.h"
+#include "Statistics.h"
+#include "Utf8.h"
 
 namespace Com
 {
@@ -6,22 +9,32 @@ namespace Com
 	{
 		TypeLibrary::TypeLibrary(const std::string& fileName)
 		{
-			auto hr = ::LoadTypeLib(Put(fileName), &typeLibrary);
+			auto hr = TypeLibrarySource::LoadTypeLibrary(fileName, &typeLibrary);
 			CheckError(hr, __FUNCTION__, "LoadTypeLib");
 
+			COM_IMPORT_COUNT_CALL("GetLibAttr");
 			hr = typeLibrary->GetLibAttr(&attributes);
 			CheckError(hr, __FUNCTION__, "GetLibAttr");
 		}
 		TypeLibrary::TypeLibrary(Pointer<ITypeLib> typeLibrary)
 			: typeLibrary(typeLibrary)
 		{
+			COM_IMPORT_COUNT_CALL("GetLibAttr");
 			auto hr = typeLibrary->GetLibAttr(&attributes);
 			CheckError(hr, __FUNCTION__, "GetLibAttr");
 		}
 		TypeLibrary::~TypeLibrary()
 		{
 			if (attributes != nullptr)
+			{
+				COM_IMPORT_COUNT_CALL("ReleaseTLibAttr");
 				typeLibrary->ReleaseTLibAttr(attributes);
+			}
+		}
+
+		const TLIBATTR& TypeLibrary::GetAttributes() const
+		{
+			return *attributes;
 		}
 
 		const GUID& TypeLibrary::GetId() const
@@ -41,20 +54,23 @@ namespace Com
 
 		std::string TypeLibrary::GetName() const
 		{
-			std::string name;
-			auto hr = typeLibrary->GetDocumentation(-1, Get(name), nullptr, nullptr, nullptr);
+			Utf8::Result text;
+			COM_IMPORT_COUNT_CALL("GetDocumentation");
+			auto hr = typeLibrary->GetDocumentation(-1, text, nullptr, nullptr, nullptr);
 			CheckError(hr, __FUNCTION__, "GetDocumentation");
-			return name;
+			return text.ToString();
 		}
 
 		UINT TypeLibrary::GetTypeInfoCount() const
 		{
+			COM_IMPORT_COUNT_CALL("GetTypeInfoCount");
 			return typeLibrary->GetTypeInfoCount();
 		}
 
 		Pointer<ITypeInfo> TypeLibrary::GetTypeInfo(UINT index) const
 		{
 			Pointer<ITypeInfo> typeInfo;
+			COM_IMPORT_COUNT_CALL("GetTypeInfo");
 			auto hr = typeLibrary->GetTypeInfo(index, &typeInfo);
 			CheckError(hr, __FUNCTION__, "GetTypeInfo");
 			return typeInfo;
@@ -62,15 +78,15 @@ namespace Com
 
 		std::string TypeLibrary::QueryPath() const
 		{
-			std::string path;
-			auto hr = ::QueryPathOfRegTypeLib(
-				attributes->guid,
-				attributes->wMajorVerNum,
-				attributes->wMinorVerNum,
-				attributes->lcid,
-				Get(path));
+			return QueryPath(*attributes);
+		}
+
+		std::string TypeLibrary::QueryPath(const TLIBATTR& attributes)
+		{
+			Utf8::Result text;
+			auto hr = TypeLibrarySource::QueryTypeLibraryPath(attributes, text);
 			CheckError(hr, __FUNCTION__, "QueryPathOfRegTypeLib");
-			return path;
+			return text.ToString();
 		}
 	}
 }
@@ -20,6 +20,7 @@ namespace Com
 
 			TypeLibrary& operator=(const TypeLibrary& rhs) = delete;
 
+			const TLIBATTR& GetAttributes() const;
 			const GUID& GetId() const;
 			WORD GetMajorVersion() const;
 			WORD GetMinorVersion() const;
@@ -27,6 +28,8 @@ namespace Com
 			UINT GetTypeInfoCount() const;
 			Pointer<ITypeInfo> GetTypeInfo(UINT index) const;
 			std::string QueryPath() const;
+
+			static std::string QueryPath(const TLIBATTR& attributes);
 		};
 	}
 }
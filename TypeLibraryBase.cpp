@@ -0,0 +1,83 @@
+#include "TypeLibraryBase.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		HRESULT TypeLibraryBase::QueryInterface(REFIID riid, void** ppvObject)
+		{
+			if (ppvObject == nullptr)
+				return E_POINTER;
+			if (riid != IID_IUnknown && riid != IID_ITypeLib)
+			{
+				*ppvObject = nullptr;
+				return E_NOINTERFACE;
+			}
+			*ppvObject = static_cast<ITypeLib*>(this);
+			AddRef();
+			return S_OK;
+		}
+
+		ULONG TypeLibraryBase::AddRef()
+		{
+			return ::InterlockedIncrement(&references);
+		}
+
+		ULONG TypeLibraryBase::Release()
+		{
+			auto result = ::InterlockedDecrement(&references);
+			if (result == 0)
+				delete this;
+			return result;
+		}
+
+		UINT TypeLibraryBase::GetTypeInfoCount()
+		{
+			return 0;
+		}
+
+		HRESULT TypeLibraryBase::GetTypeInfo(UINT, ITypeInfo**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::GetTypeInfoType(UINT, TYPEKIND*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::GetTypeInfoOfGuid(REFGUID, ITypeInfo**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::GetLibAttr(TLIBATTR**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::GetTypeComp(ITypeComp**)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::GetDocumentation(INT, BSTR*, BSTR*, DWORD*, BSTR*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::IsName(LPOLESTR, ULONG, BOOL*)
+		{
+			return E_NOTIMPL;
+		}
+
+		HRESULT TypeLibraryBase::FindName(LPOLESTR, ULONG, ITypeInfo**, MEMBERID*, USHORT*)
+		{
+			return E_NOTIMPL;
+		}
+
+		void TypeLibraryBase::ReleaseTLibAttr(TLIBATTR*)
+		{
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <objbase.h>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryBase : public ITypeLib
+		{
+		private:
+			long references = 1;
+
+		public:
+			TypeLibraryBase() = default;
+			TypeLibraryBase(const TypeLibraryBase& rhs) = delete;
+			virtual ~TypeLibraryBase() = default;
+
+			TypeLibraryBase& operator=(const TypeLibraryBase& rhs) = delete;
+
+			HRESULT __stdcall QueryInterface(REFIID riid, void** ppvObject) override;
+			ULONG __stdcall AddRef() override;
+			ULONG __stdcall Release() override;
+
+			UINT __stdcall GetTypeInfoCount() override;
+			HRESULT __stdcall GetTypeInfo(UINT index, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetTypeInfoType(UINT index, TYPEKIND* typeKind) override;
+			HRESULT __stdcall GetTypeInfoOfGuid(REFGUID guid, ITypeInfo** typeInfo) override;
+			HRESULT __stdcall GetLibAttr(TLIBATTR** attributes) override;
+			HRESULT __stdcall GetTypeComp(ITypeComp** typeComp) override;
+			HRESULT __stdcall GetDocumentation(INT index, BSTR* name, BSTR* documentation, DWORD* helpContext, BSTR* helpFile) override;
+			HRESULT __stdcall IsName(LPOLESTR name, ULONG hash, BOOL* result) override;
+			HRESULT __stdcall FindName(LPOLESTR name, ULONG hash, ITypeInfo** typeInfos, MEMBERID* members, USHORT* found) override;
+			void __stdcall ReleaseTLibAttr(TLIBATTR* attributes) override;
+		};
+	}
+}
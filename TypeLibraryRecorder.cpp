@@ -0,0 +1,144 @@
+#include "TypeLibraryRecorder.h"
+#include "RecordingTypeLibrary.h"
+#include "RecordingTypeInfo.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		TypeLibraryRecorder::~TypeLibraryRecorder()
+		{
+			for (auto library : libraries)
+				library->Release();
+		}
+
+		HRESULT TypeLibraryRecorder::Load(const std::string& fileName, ITypeLib** typeLibrary)
+		{
+			Pointer<ITypeLib> library;
+			auto hr = LoadFromFile(fileName, &library);
+			if (FAILED(hr))
+				return hr;
+
+			UINT index = 0;
+			hr = WrapLibrary(library, index);
+			if (FAILED(hr))
+				return hr;
+
+			trace.GetLibraries()[index].FileNames.push_back(fileName);
+			*typeLibrary = libraries[index];
+			(*typeLibrary)->AddRef();
+			return S_OK;
+		}
+
+		HRESULT TypeLibraryRecorder::QueryPath(const TLIBATTR& attributes, BSTR* path)
+		{
+			auto hr = QueryRegistry(attributes, path);
+			if (FAILED(hr))
+				return hr;
+
+			auto found = libraryIndices.find(GetKey(attributes));
+			if (found != libraryIndices.end())
+				trace.GetLibraries()[found->second].Path.assign(*path, ::SysStringLen(*path));
+			return hr;
+		}
+
+		TypeLibraryTrace& TypeLibraryRecorder::GetTrace()
+		{
+			return trace;
+		}
+
+		TypeTrace& TypeLibraryRecorder::GetType(const TypeReferenceTrace& reference)
+		{
+			return trace.GetLibraries()[reference.Library].Types[reference.Type];
+		}
+
+		ITypeLib* TypeLibraryRecorder::GetLibrary(UINT index) const
+		{
+			return libraries[index];
+		}
+
+		HRESULT TypeLibraryRecorder::WrapTypeInfo(Pointer<ITypeInfo> typeInfo, TypeReferenceTrace& reference, ITypeInfo** result)
+		{
+			Pointer<ITypeLib> library;
+			auto hr = typeInfo->GetContainingTypeLib(&library, &reference.Type);
+			if (FAILED(hr))
+				return hr;
+
+			hr = WrapLibrary(library, reference.Library);
+			if (FAILED(hr))
+				return hr;
+
+			return WrapTypeInfo(reference, typeInfo, result);
+		}
+
+		HRESULT TypeLibraryRecorder::WrapTypeInfo(const TypeReferenceTrace& reference, Pointer<ITypeInfo> typeInfo, ITypeInfo** result)
+		{
+			Pointer<ITypeInfo2> typeInfo2;
+			auto hr = typeInfo->QueryInterface(&typeInfo2);
+			if (FAILED(hr))
+				return hr;
+
+			auto& types = trace.GetLibraries()[reference.Library].Types;
+			if (types.find(reference.Type) == types.end())
+			{
+				TYPEATTR* attributes = nullptr;
+				hr = typeInfo2->GetTypeAttr(&attributes);
+				if (FAILED(hr))
+					return hr;
+				types[reference.Type].Attributes = trace.CopyAttributes(*attributes);
+				typeInfo2->ReleaseTypeAttr(attributes);
+			}
+
+			*result = new RecordingTypeInfo(*this, reference, typeInfo2);
+			return S_OK;
+		}
+
+		void TypeLibraryRecorder::Save(const std::string& fileName) const
+		{
+			trace.Save(fileName);
+		}
+
+		HRESULT TypeLibraryRecorder::WrapLibrary(Pointer<ITypeLib> typeLibrary, UINT& index)
+		{
+			TLIBATTR* attributes = nullptr;
+			auto hr = typeLibrary->GetLibAttr(&attributes);
+			if (FAILED(hr))
+				return hr;
+			auto key = GetKey(*attributes);
+			auto found = libraryIndices.find(key);
+			if (found != libraryIndices.end())
+			{
+				typeLibrary->ReleaseTLibAttr(attributes);
+				index = found->second;
+				return S_OK;
+			}
+
+			BSTR name = nullptr;
+			hr = typeLibrary->GetDocumentation(-1, &name, nullptr, nullptr, nullptr);
+			if (FAILED(hr))
+			{
+				typeLibrary->ReleaseTLibAttr(attributes);
+				return hr;
+			}
+
+			auto& library = trace.AddLibrary(*attributes, typeLibrary->GetTypeInfoCount());
+			typeLibrary->ReleaseTLibAttr(attributes);
+			library.Name.assign(name, ::SysStringLen(name));
+			::SysFreeString(name);
+
+			index = static_cast<UINT>(libraries.size());
+			libraryIndices[key] = index;
+			libraries.push_back(new RecordingTypeLibrary(*this, index, typeLibrary));
+			return S_OK;
+		}
+
+		std::string TypeLibraryRecorder::GetKey(const TLIBATTR& attributes)
+		{
+			std::string key(reinterpret_cast<const char*>(&attributes.guid), sizeof(attributes.guid));
+			key.append(reinterpret_cast<const char*>(&attributes.lcid), sizeof(attributes.lcid));
+			key.append(reinterpret_cast<const char*>(&attributes.wMajorVerNum), sizeof(attributes.wMajorVerNum));
+			key.append(reinterpret_cast<const char*>(&attributes.wMinorVerNum), sizeof(attributes.wMinorVerNum));
+			return key;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "TypeLibrarySource.h"
+#include "TypeLibraryTrace.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryRecorder : public TypeLibrarySource
+		{
+		private:
+			TypeLibraryTrace trace;
+			std::map<std::string, UINT> libraryIndices;
+			std::vector<ITypeLib*> libraries;
+
+		public:
+			TypeLibraryRecorder() = default;
+			TypeLibraryRecorder(const TypeLibraryRecorder& rhs) = delete;
+			~TypeLibraryRecorder();
+
+			TypeLibraryRecorder& operator=(const TypeLibraryRecorder& rhs) = delete;
+
+			HRESULT Load(const std::string& fileName, ITypeLib** typeLibrary) override;
+			HRESULT QueryPath(const TLIBATTR& attributes, BSTR* path) override;
+
+			TypeLibraryTrace& GetTrace();
+			TypeTrace& GetType(const TypeReferenceTrace& reference);
+			ITypeLib* GetLibrary(UINT index) const;
+			HRESULT WrapTypeInfo(Pointer<ITypeInfo> typeInfo, TypeReferenceTrace& reference, ITypeInfo** result);
+			HRESULT WrapTypeInfo(const TypeReferenceTrace& reference, Pointer<ITypeInfo> typeInfo, ITypeInfo** result);
+			void Save(const std::string& fileName) const;
+
+		private:
+			HRESULT WrapLibrary(Pointer<ITypeLib> typeLibrary, UINT& index);
+			static std::string GetKey(const TLIBATTR& attributes);
+		};
+	}
+}
@@ -0,0 +1,78 @@
+#include "TypeLibraryReplayer.h"
+#include "ReplayTypeLibrary.h"
+#include "ReplayTypeInfo.h"
+#include <algorithm>
+
+namespace Com
+{
+	namespace Import
+	{
+		TypeLibraryReplayer::TypeLibraryReplayer(TypeLibraryTrace&& trace)
+			: trace(std::move(trace))
+		{
+			auto& recorded = this->trace.GetLibraries();
+			for (auto index = 0u; index < recorded.size(); ++index)
+				libraries.push_back(new ReplayTypeLibrary(*this, index, recorded[index]));
+		}
+
+		TypeLibraryReplayer::~TypeLibraryReplayer()
+		{
+			for (auto library : libraries)
+				library->Release();
+		}
+
+		HRESULT TypeLibraryReplayer::Load(const std::string& fileName, ITypeLib** typeLibrary)
+		{
+			auto& recorded = trace.GetLibraries();
+			for (auto index = 0u; index < recorded.size(); ++index)
+			{
+				auto& fileNames = recorded[index].FileNames;
+				if (std::find(fileNames.begin(), fileNames.end(), fileName) == fileNames.end())
+					continue;
+				*typeLibrary = libraries[index];
+				(*typeLibrary)->AddRef();
+				return S_OK;
+			}
+			return TYPE_E_CANTLOADLIBRARY;
+		}
+
+		HRESULT TypeLibraryReplayer::QueryPath(const TLIBATTR& attributes, BSTR* path)
+		{
+			for (auto& library : trace.GetLibraries())
+			{
+				if (library.Attributes.guid != attributes.guid ||
+					library.Attributes.lcid != attributes.lcid ||
+					library.Attributes.wMajorVerNum != attributes.wMajorVerNum ||
+					library.Attributes.wMinorVerNum != attributes.wMinorVerNum ||
+					library.Path.empty())
+					continue;
+				*path = AllocateString(library.Path);
+				return S_OK;
+			}
+			return TYPE_E_LIBNOTREGISTERED;
+		}
+
+		ITypeLib* TypeLibraryReplayer::GetLibrary(UINT index) const
+		{
+			return libraries[index];
+		}
+
+		HRESULT TypeLibraryReplayer::CreateTypeInfo(const TypeReferenceTrace& reference, ITypeInfo** typeInfo)
+		{
+			auto& recorded = trace.GetLibraries();
+			if (reference.Library >= recorded.size())
+				return TYPE_E_ELEMENTNOTFOUND;
+			auto& types = recorded[reference.Library].Types;
+			auto found = types.find(reference.Type);
+			if (found == types.end())
+				return TYPE_E_ELEMENTNOTFOUND;
+			*typeInfo = new ReplayTypeInfo(*this, reference, found->second);
+			return S_OK;
+		}
+
+		BSTR TypeLibraryReplayer::AllocateString(const std::wstring& value)
+		{
+			return ::SysAllocStringLen(value.data(), static_cast<UINT>(value.size()));
+		}
+	}
+}
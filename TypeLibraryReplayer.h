@@ -0,0 +1,33 @@
+#pragma once
+#include "TypeLibrarySource.h"
+#include "TypeLibraryTrace.h"
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibraryReplayer : public TypeLibrarySource
+		{
+		private:
+			TypeLibraryTrace trace;
+			std::vector<ITypeLib*> libraries;
+
+		public:
+			TypeLibraryReplayer(TypeLibraryTrace&& trace);
+			TypeLibraryReplayer(const TypeLibraryReplayer& rhs) = delete;
+			~TypeLibraryReplayer();
+
+			TypeLibraryReplayer& operator=(const TypeLibraryReplayer& rhs) = delete;
+
+			HRESULT Load(const std::string& fileName, ITypeLib** typeLibrary) override;
+			HRESULT QueryPath(const TLIBATTR& attributes, BSTR* path) override;
+
+			ITypeLib* GetLibrary(UINT index) const;
+			HRESULT CreateTypeInfo(const TypeReferenceTrace& reference, ITypeInfo** typeInfo);
+
+			static BSTR AllocateString(const std::wstring& value);
+		};
+	}
+}
@@ -0,0 +1,52 @@
+#include "TypeLibrarySource.h"
+
+namespace Com
+{
+	namespace Import
+	{
+		TypeLibrarySource::TypeLibrarySource()
+		{
+			GetInstance() = this;
+		}
+
+		TypeLibrarySource::~TypeLibrarySource()
+		{
+			GetInstance() = nullptr;
+		}
+
+		HRESULT TypeLibrarySource::LoadTypeLibrary(const std::string& fileName, ITypeLib** typeLibrary)
+		{
+			if (GetInstance() != nullptr)
+				return GetInstance()->Load(fileName, typeLibrary);
+			return LoadFromFile(fileName, typeLibrary);
+		}
+
+		HRESULT TypeLibrarySource::QueryTypeLibraryPath(const TLIBATTR& attributes, BSTR* path)
+		{
+			if (GetInstance() != nullptr)
+				return GetInstance()->QueryPath(attributes, path);
+			return QueryRegistry(attributes, path);
+		}
+
+		HRESULT TypeLibrarySource::LoadFromFile(const std::string& fileName, ITypeLib** typeLibrary)
+		{
+			return ::LoadTypeLib(Put(fileName), typeLibrary);
+		}
+
+		HRESULT TypeLibrarySource::QueryRegistry(const TLIBATTR& attributes, BSTR* path)
+		{
+			return ::QueryPathOfRegTypeLib(
+				attributes.guid,
+				attributes.wMajorVerNum,
+				attributes.wMinorVerNum,
+				attributes.lcid,
+				path);
+		}
+
+		TypeLibrarySource*& TypeLibrarySource::GetInstance()
+		{
+			static TypeLibrarySource* instance = nullptr;
+			return instance;
+		}
+	}
+}
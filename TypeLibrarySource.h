@@ -0,0 +1,29 @@
+#pragma once
+#include <Com/Com.h>
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class TypeLibrarySource
+		{
+		public:
+			TypeLibrarySource();
+			virtual ~TypeLibrarySource();
+
+			virtual HRESULT Load(const std::string& fileName, ITypeLib** typeLibrary) = 0;
+			virtual HRESULT QueryPath(const TLIBATTR& attributes, BSTR* path) = 0;
+
+			static HRESULT LoadTypeLibrary(const std::string& fileName, ITypeLib** typeLibrary);
+			static HRESULT QueryTypeLibraryPath(const TLIBATTR& attributes, BSTR* path);
+
+		protected:
+			static HRESULT LoadFromFile(const std::string& fileName, ITypeLib** typeLibrary);
+			static HRESULT QueryRegistry(const TLIBATTR& attributes, BSTR* path);
+
+		private:
+			static TypeLibrarySource*& GetInstance();
+		};
+	}
+}
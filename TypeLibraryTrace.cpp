@@ -0,0 +1,581 @@
+#include "TypeLibraryTrace.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const std::uint32_t traceSignature = 0x52544943;
+			const std::uint32_t traceVersion = 2;
+		}
+
+		std::deque<LibraryTrace>& TypeLibraryTrace::GetLibraries()
+		{
+			return libraries;
+		}
+
+		const std::deque<LibraryTrace>& TypeLibraryTrace::GetLibraries() const
+		{
+			return libraries;
+		}
+
+		LibraryTrace& TypeLibraryTrace::AddLibrary(const TLIBATTR& attributes, UINT typeCount)
+		{
+			libraries.push_back({});
+			auto& library = libraries.back();
+			library.Attributes = attributes;
+			library.TypeCount = typeCount;
+			return library;
+		}
+
+		TYPEATTR TypeLibraryTrace::CopyAttributes(const TYPEATTR& attributes)
+		{
+			TYPEATTR result{};
+			result.guid = attributes.guid;
+			result.lcid = attributes.lcid;
+			result.memidConstructor = attributes.memidConstructor;
+			result.memidDestructor = attributes.memidDestructor;
+			result.cbSizeInstance = attributes.cbSizeInstance;
+			result.typekind = attributes.typekind;
+			result.cFuncs = attributes.cFuncs;
+			result.cVars = attributes.cVars;
+			result.cImplTypes = attributes.cImplTypes;
+			result.cbSizeVft = attributes.cbSizeVft;
+			result.cbAlignment = attributes.cbAlignment;
+			result.wTypeFlags = attributes.wTypeFlags;
+			result.wMajorVerNum = attributes.wMajorVerNum;
+			result.wMinorVerNum = attributes.wMinorVerNum;
+			result.idldescType.wIDLFlags = attributes.idldescType.wIDLFlags;
+			if (attributes.typekind == TKIND_ALIAS)
+				result.tdescAlias = CopyType(attributes.tdescAlias);
+			return result;
+		}
+
+		FunctionTrace TypeLibraryTrace::CopyFunction(const FUNCDESC& description)
+		{
+			FunctionTrace result{};
+			result.Description.memid = description.memid;
+			result.Description.funckind = description.funckind;
+			result.Description.invkind = description.invkind;
+			result.Description.callconv = description.callconv;
+			result.Description.cParams = description.cParams;
+			result.Description.cParamsOpt = description.cParamsOpt;
+			result.Description.oVft = description.oVft;
+			result.Description.wFuncFlags = description.wFuncFlags;
+			result.Description.elemdescFunc = CopyElement(description.elemdescFunc);
+			for (auto index = 0; index < description.cParams; ++index)
+				result.Parameters.push_back(CopyElement(description.lprgelemdescParam[index]));
+			return result;
+		}
+
+		VariableTrace TypeLibraryTrace::CopyVariable(const VARDESC& description)
+		{
+			VariableTrace result{};
+			result.Description.memid = description.memid;
+			result.Description.varkind = description.varkind;
+			result.Description.wVarFlags = description.wVarFlags;
+			result.Description.elemdescVar = CopyElement(description.elemdescVar);
+			if (description.varkind != VAR_CONST)
+				result.Description.oInst = description.oInst;
+			else if (FAILED(::VariantChangeType(&result.Value, description.lpvarValue, 0, VT_I4)))
+				result.Value.vt = VT_EMPTY;
+			return result;
+		}
+
+		TYPEDESC TypeLibraryTrace::CopyType(const TYPEDESC& description)
+		{
+			TYPEDESC result{};
+			result.vt = description.vt;
+			switch (description.vt)
+			{
+			case VT_PTR:
+			case VT_SAFEARRAY:
+			{
+				auto element = static_cast<TYPEDESC*>(Allocate(sizeof(TYPEDESC)));
+				*element = CopyType(*description.lptdesc);
+				result.lptdesc = element;
+				break;
+			}
+			case VT_CARRAY:
+			{
+				auto& source = *description.lpadesc;
+				auto dimensions = source.cDims > 0 ? source.cDims : 1;
+				auto array = static_cast<ARRAYDESC*>(Allocate(sizeof(ARRAYDESC) + (dimensions - 1) * sizeof(SAFEARRAYBOUND)));
+				array->tdescElem = CopyType(source.tdescElem);
+				array->cDims = source.cDims;
+				for (auto index = 0; index < source.cDims; ++index)
+					array->rgbounds[index] = source.rgbounds[index];
+				result.lpadesc = array;
+				break;
+			}
+			case VT_USERDEFINED:
+				result.hreftype = description.hreftype;
+				break;
+			}
+			return result;
+		}
+
+		ELEMDESC TypeLibraryTrace::CopyElement(const ELEMDESC& description)
+		{
+			ELEMDESC result{};
+			result.tdesc = CopyType(description.tdesc);
+			result.paramdesc.wParamFlags = description.paramdesc.wParamFlags & ~PARAMFLAG_FHASDEFAULT;
+			return result;
+		}
+
+		void TypeLibraryTrace::Save(const std::string& fileName) const
+		{
+			std::ofstream out{ fileName.c_str(), std::ios::binary };
+			WriteDword(out, traceSignature);
+			WriteDword(out, traceVersion);
+			WriteDword(out, static_cast<std::uint32_t>(libraries.size()));
+			for (auto& library : libraries)
+				WriteLibrary(out, library);
+			out.close();
+			if (!out)
+				throw std::runtime_error("Unable to write type library trace: " + fileName);
+		}
+
+		TypeLibraryTrace TypeLibraryTrace::Load(const std::string& fileName)
+		{
+			std::ifstream in{ fileName.c_str(), std::ios::binary };
+			if (!in)
+				throw std::runtime_error("Unable to open type library trace: " + fileName);
+			in.exceptions(std::ios::failbit | std::ios::badbit);
+			TypeLibraryTrace trace;
+			try
+			{
+				if (ReadDword(in) != traceSignature || ReadDword(in) != traceVersion)
+					throw std::runtime_error("Unsupported type library trace format.");
+				auto count = ReadDword(in);
+				for (auto index = 0u; index < count; ++index)
+				{
+					trace.libraries.push_back({});
+					trace.ReadLibrary(in, trace.libraries.back());
+				}
+			}
+			catch (const std::ios::failure&)
+			{
+				throw std::runtime_error("Truncated type library trace: " + fileName);
+			}
+			return trace;
+		}
+
+		void* TypeLibraryTrace::Allocate(std::size_t size)
+		{
+			blocks.emplace_back(new unsigned char[size]());
+			return blocks.back().get();
+		}
+
+		void TypeLibraryTrace::WriteLibrary(std::ostream& out, const LibraryTrace& library)
+		{
+			WriteDword(out, static_cast<std::uint32_t>(library.FileNames.size()));
+			for (auto& fileName : library.FileNames)
+				WriteString(out, fileName);
+			WriteWideString(out, library.Path);
+			WriteWideString(out, library.Name);
+			WriteGuid(out, library.Attributes.guid);
+			WriteDword(out, library.Attributes.lcid);
+			WriteDword(out, static_cast<std::uint32_t>(library.Attributes.syskind));
+			WriteWord(out, library.Attributes.wMajorVerNum);
+			WriteWord(out, library.Attributes.wMinorVerNum);
+			WriteWord(out, library.Attributes.wLibFlags);
+			WriteDword(out, library.TypeCount);
+			WriteDword(out, static_cast<std::uint32_t>(library.Types.size()));
+			for (auto& type : library.Types)
+			{
+				WriteDword(out, type.first);
+				WriteTypeInfo(out, type.second);
+			}
+		}
+
+		void TypeLibraryTrace::WriteTypeInfo(std::ostream& out, const TypeTrace& type)
+		{
+			auto& attributes = type.Attributes;
+			WriteGuid(out, attributes.guid);
+			WriteDword(out, attributes.lcid);
+			WriteDword(out, static_cast<std::uint32_t>(attributes.memidConstructor));
+			WriteDword(out, static_cast<std::uint32_t>(attributes.memidDestructor));
+			WriteDword(out, attributes.cbSizeInstance);
+			WriteDword(out, static_cast<std::uint32_t>(attributes.typekind));
+			WriteWord(out, attributes.cFuncs);
+			WriteWord(out, attributes.cVars);
+			WriteWord(out, attributes.cImplTypes);
+			WriteWord(out, attributes.cbSizeVft);
+			WriteWord(out, attributes.cbAlignment);
+			WriteWord(out, attributes.wTypeFlags);
+			WriteWord(out, attributes.wMajorVerNum);
+			WriteWord(out, attributes.wMinorVerNum);
+			WriteWord(out, attributes.idldescType.wIDLFlags);
+			WriteType(out, attributes.tdescAlias);
+
+			WriteDword(out, static_cast<std::uint32_t>(type.Documentation.size()));
+			for (auto& documentation : type.Documentation)
+			{
+				WriteDword(out, static_cast<std::uint32_t>(documentation.first));
+				WriteWideString(out, documentation.second);
+			}
+			WriteDword(out, static_cast<std::uint32_t>(type.Names.size()));
+			for (auto& names : type.Names)
+			{
+				WriteDword(out, static_cast<std::uint32_t>(names.first));
+				WriteDword(out, static_cast<std::uint32_t>(names.second.size()));
+				for (auto& name : names.second)
+					WriteWideString(out, name);
+			}
+			WriteDword(out, static_cast<std::uint32_t>(type.Functions.size()));
+			for (auto& function : type.Functions)
+			{
+				WriteDword(out, function.first);
+				WriteFunction(out, function.second);
+			}
+			WriteDword(out, static_cast<std::uint32_t>(type.Variables.size()));
+			for (auto& variable : type.Variables)
+			{
+				WriteDword(out, variable.first);
+				WriteVariable(out, variable.second);
+			}
+			WriteDword(out, static_cast<std::uint32_t>(type.ImplementedTypes.size()));
+			for (auto& implementedType : type.ImplementedTypes)
+			{
+				WriteDword(out, implementedType.first);
+				WriteDword(out, implementedType.second);
+			}
+			WriteDword(out, static_cast<std::uint32_t>(type.References.size()));
+			for (auto& reference : type.References)
+			{
+				WriteDword(out, reference.first);
+				WriteDword(out, reference.second.Library);
+				WriteDword(out, reference.second.Type);
+			}
+		}
+
+		void TypeLibraryTrace::WriteFunction(std::ostream& out, const FunctionTrace& function)
+		{
+			auto& description = function.Description;
+			WriteDword(out, static_cast<std::uint32_t>(description.memid));
+			WriteDword(out, static_cast<std::uint32_t>(description.funckind));
+			WriteDword(out, static_cast<std::uint32_t>(description.invkind));
+			WriteDword(out, static_cast<std::uint32_t>(description.callconv));
+			WriteWord(out, static_cast<std::uint16_t>(description.cParamsOpt));
+			WriteWord(out, static_cast<std::uint16_t>(description.oVft));
+			WriteWord(out, description.wFuncFlags);
+			WriteElement(out, description.elemdescFunc);
+			WriteDword(out, static_cast<std::uint32_t>(function.Parameters.size()));
+			for (auto& parameter : function.Parameters)
+				WriteElement(out, parameter);
+		}
+
+		void TypeLibraryTrace::WriteVariable(std::ostream& out, const VariableTrace& variable)
+		{
+			auto& description = variable.Description;
+			WriteDword(out, static_cast<std::uint32_t>(description.memid));
+			WriteDword(out, static_cast<std::uint32_t>(description.varkind));
+			WriteWord(out, description.wVarFlags);
+			WriteElement(out, description.elemdescVar);
+			if (description.varkind == VAR_CONST)
+			{
+				WriteWord(out, variable.Value.vt);
+				WriteDword(out, static_cast<std::uint32_t>(variable.Value.lVal));
+			}
+			else
+				WriteDword(out, description.oInst);
+		}
+
+		void TypeLibraryTrace::WriteElement(std::ostream& out, const ELEMDESC& description)
+		{
+			WriteType(out, description.tdesc);
+			WriteWord(out, description.paramdesc.wParamFlags);
+		}
+
+		void TypeLibraryTrace::WriteType(std::ostream& out, const TYPEDESC& description)
+		{
+			WriteWord(out, description.vt);
+			switch (description.vt)
+			{
+			case VT_PTR:
+			case VT_SAFEARRAY:
+				WriteType(out, *description.lptdesc);
+				break;
+			case VT_CARRAY:
+				WriteType(out, description.lpadesc->tdescElem);
+				WriteWord(out, description.lpadesc->cDims);
+				for (auto index = 0; index < description.lpadesc->cDims; ++index)
+				{
+					WriteDword(out, description.lpadesc->rgbounds[index].cElements);
+					WriteDword(out, static_cast<std::uint32_t>(description.lpadesc->rgbounds[index].lLbound));
+				}
+				break;
+			case VT_USERDEFINED:
+				WriteDword(out, description.hreftype);
+				break;
+			}
+		}
+
+		void TypeLibraryTrace::WriteString(std::ostream& out, const std::string& value)
+		{
+			WriteDword(out, static_cast<std::uint32_t>(value.size()));
+			out.write(value.data(), value.size());
+		}
+
+		void TypeLibraryTrace::WriteWideString(std::ostream& out, const std::wstring& value)
+		{
+			// Written as UTF-16 code units whatever the width of wchar_t, so traces replay on any host.
+			std::vector<std::uint16_t> units;
+			units.reserve(value.size());
+			for (auto character : value)
+			{
+				auto codePoint = static_cast<std::uint32_t>(character);
+				if (codePoint > 0xFFFF)
+				{
+					codePoint -= 0x10000;
+					units.push_back(static_cast<std::uint16_t>(0xD800 + (codePoint >> 10)));
+					units.push_back(static_cast<std::uint16_t>(0xDC00 + (codePoint & 0x3FF)));
+				}
+				else
+					units.push_back(static_cast<std::uint16_t>(codePoint));
+			}
+			WriteDword(out, static_cast<std::uint32_t>(units.size()));
+			for (auto unit : units)
+				WriteWord(out, unit);
+		}
+
+		void TypeLibraryTrace::WriteWord(std::ostream& out, std::uint16_t value)
+		{
+			const char bytes[] = { static_cast<char>(value & 0xFF), static_cast<char>(value >> 8) };
+			out.write(bytes, sizeof(bytes));
+		}
+
+		void TypeLibraryTrace::WriteDword(std::ostream& out, std::uint32_t value)
+		{
+			WriteWord(out, static_cast<std::uint16_t>(value & 0xFFFF));
+			WriteWord(out, static_cast<std::uint16_t>(value >> 16));
+		}
+
+		void TypeLibraryTrace::WriteGuid(std::ostream& out, const GUID& value)
+		{
+			WriteDword(out, value.Data1);
+			WriteWord(out, value.Data2);
+			WriteWord(out, value.Data3);
+			out.write(reinterpret_cast<const char*>(value.Data4), sizeof(value.Data4));
+		}
+
+		void TypeLibraryTrace::ReadLibrary(std::istream& in, LibraryTrace& library)
+		{
+			auto fileNameCount = ReadDword(in);
+			for (auto index = 0u; index < fileNameCount; ++index)
+				library.FileNames.push_back(ReadString(in));
+			library.Path = ReadWideString(in);
+			library.Name = ReadWideString(in);
+			library.Attributes.guid = ReadGuid(in);
+			library.Attributes.lcid = ReadDword(in);
+			library.Attributes.syskind = static_cast<SYSKIND>(ReadDword(in));
+			library.Attributes.wMajorVerNum = ReadWord(in);
+			library.Attributes.wMinorVerNum = ReadWord(in);
+			library.Attributes.wLibFlags = ReadWord(in);
+			library.TypeCount = ReadDword(in);
+			auto count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto typeIndex = ReadDword(in);
+				ReadTypeInfo(in, library.Types[typeIndex]);
+			}
+		}
+
+		void TypeLibraryTrace::ReadTypeInfo(std::istream& in, TypeTrace& type)
+		{
+			auto& attributes = type.Attributes;
+			attributes = {};
+			attributes.guid = ReadGuid(in);
+			attributes.lcid = ReadDword(in);
+			attributes.memidConstructor = static_cast<MEMBERID>(ReadDword(in));
+			attributes.memidDestructor = static_cast<MEMBERID>(ReadDword(in));
+			attributes.cbSizeInstance = ReadDword(in);
+			attributes.typekind = static_cast<TYPEKIND>(ReadDword(in));
+			attributes.cFuncs = ReadWord(in);
+			attributes.cVars = ReadWord(in);
+			attributes.cImplTypes = ReadWord(in);
+			attributes.cbSizeVft = ReadWord(in);
+			attributes.cbAlignment = ReadWord(in);
+			attributes.wTypeFlags = ReadWord(in);
+			attributes.wMajorVerNum = ReadWord(in);
+			attributes.wMinorVerNum = ReadWord(in);
+			attributes.idldescType.wIDLFlags = ReadWord(in);
+			ReadType(in, attributes.tdescAlias);
+
+			auto count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto member = static_cast<MEMBERID>(ReadDword(in));
+				type.Documentation[member] = ReadWideString(in);
+			}
+			count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto& names = type.Names[static_cast<MEMBERID>(ReadDword(in))];
+				auto nameCount = ReadDword(in);
+				for (auto nameIndex = 0u; nameIndex < nameCount; ++nameIndex)
+					names.push_back(ReadWideString(in));
+			}
+			count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto functionIndex = ReadDword(in);
+				ReadFunction(in, type.Functions[functionIndex]);
+			}
+			count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto variableIndex = ReadDword(in);
+				ReadVariable(in, type.Variables[variableIndex]);
+			}
+			count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto implementedIndex = ReadDword(in);
+				type.ImplementedTypes[implementedIndex] = ReadDword(in);
+			}
+			count = ReadDword(in);
+			for (auto index = 0u; index < count; ++index)
+			{
+				auto handle = ReadDword(in);
+				auto library = ReadDword(in);
+				type.References[handle] = { library, ReadDword(in) };
+			}
+		}
+
+		void TypeLibraryTrace::ReadFunction(std::istream& in, FunctionTrace& function)
+		{
+			auto& description = function.Description;
+			description = {};
+			description.memid = static_cast<MEMBERID>(ReadDword(in));
+			description.funckind = static_cast<FUNCKIND>(ReadDword(in));
+			description.invkind = static_cast<INVOKEKIND>(ReadDword(in));
+			description.callconv = static_cast<CALLCONV>(ReadDword(in));
+			description.cParamsOpt = static_cast<SHORT>(ReadWord(in));
+			description.oVft = static_cast<SHORT>(ReadWord(in));
+			description.wFuncFlags = ReadWord(in);
+			ReadElement(in, description.elemdescFunc);
+			auto count = ReadDword(in);
+			function.Parameters.resize(count);
+			for (auto& parameter : function.Parameters)
+				ReadElement(in, parameter);
+			description.cParams = static_cast<SHORT>(count);
+		}
+
+		void TypeLibraryTrace::ReadVariable(std::istream& in, VariableTrace& variable)
+		{
+			auto& description = variable.Description;
+			description = {};
+			variable.Value = {};
+			description.memid = static_cast<MEMBERID>(ReadDword(in));
+			description.varkind = static_cast<VARKIND>(ReadDword(in));
+			description.wVarFlags = ReadWord(in);
+			ReadElement(in, description.elemdescVar);
+			if (description.varkind == VAR_CONST)
+			{
+				variable.Value.vt = ReadWord(in);
+				variable.Value.lVal = static_cast<LONG>(ReadDword(in));
+			}
+			else
+				description.oInst = ReadDword(in);
+		}
+
+		void TypeLibraryTrace::ReadElement(std::istream& in, ELEMDESC& description)
+		{
+			description = {};
+			ReadType(in, description.tdesc);
+			description.paramdesc.wParamFlags = ReadWord(in);
+		}
+
+		void TypeLibraryTrace::ReadType(std::istream& in, TYPEDESC& description)
+		{
+			description = {};
+			description.vt = ReadWord(in);
+			switch (description.vt)
+			{
+			case VT_PTR:
+			case VT_SAFEARRAY:
+			{
+				auto element = static_cast<TYPEDESC*>(Allocate(sizeof(TYPEDESC)));
+				ReadType(in, *element);
+				description.lptdesc = element;
+				break;
+			}
+			case VT_CARRAY:
+			{
+				TYPEDESC element;
+				ReadType(in, element);
+				auto dimensions = ReadWord(in);
+				auto array = static_cast<ARRAYDESC*>(Allocate(sizeof(ARRAYDESC) + (dimensions > 0 ? dimensions - 1 : 0) * sizeof(SAFEARRAYBOUND)));
+				array->tdescElem = element;
+				array->cDims = dimensions;
+				for (auto index = 0; index < dimensions; ++index)
+				{
+					array->rgbounds[index].cElements = ReadDword(in);
+					array->rgbounds[index].lLbound = static_cast<LONG>(ReadDword(in));
+				}
+				description.lpadesc = array;
+				break;
+			}
+			case VT_USERDEFINED:
+				description.hreftype = ReadDword(in);
+				break;
+			}
+		}
+
+		std::string TypeLibraryTrace::ReadString(std::istream& in)
+		{
+			std::string value(ReadDword(in), '\0');
+			in.read(&value[0], value.size());
+			return value;
+		}
+
+		std::wstring TypeLibraryTrace::ReadWideString(std::istream& in)
+		{
+			auto count = ReadDword(in);
+			std::wstring value;
+			value.reserve(count);
+			for (auto index = 0u; index < count; ++index)
+			{
+				std::uint32_t unit = ReadWord(in);
+				// A wchar_t wider than UTF-16 holds a surrogate pair as one code point.
+				if (sizeof(wchar_t) > 2 && unit >= 0xD800 && unit < 0xDC00 && index + 1 < count)
+				{
+					auto low = ReadWord(in);
+					++index;
+					unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+				}
+				value.push_back(static_cast<wchar_t>(unit));
+			}
+			return value;
+		}
+
+		std::uint16_t TypeLibraryTrace::ReadWord(std::istream& in)
+		{
+			unsigned char bytes[2];
+			in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+			return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+		}
+
+		std::uint32_t TypeLibraryTrace::ReadDword(std::istream& in)
+		{
+			std::uint32_t low = ReadWord(in);
+			std::uint32_t high = ReadWord(in);
+			return low | (high << 16);
+		}
+
+		GUID TypeLibraryTrace::ReadGuid(std::istream& in)
+		{
+			GUID value;
+			value.Data1 = ReadDword(in);
+			value.Data2 = ReadWord(in);
+			value.Data3 = ReadWord(in);
+			in.read(reinterpret_cast<char*>(value.Data4), sizeof(value.Data4));
+			return value;
+		}
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <objbase.h>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Com
+{
+	namespace Import
+	{
+		struct TypeReferenceTrace
+		{
+			UINT Library;
+			UINT Type;
+		};
+
+		struct FunctionTrace
+		{
+			FUNCDESC Description;
+			std::vector<ELEMDESC> Parameters;
+		};
+
+		struct VariableTrace
+		{
+			VARDESC Description;
+			VARIANT Value;
+		};
+
+		struct TypeTrace
+		{
+			TYPEATTR Attributes;
+			std::map<MEMBERID, std::wstring> Documentation;
+			std::map<MEMBERID, std::vector<std::wstring>> Names;
+			std::map<UINT, FunctionTrace> Functions;
+			std::map<UINT, VariableTrace> Variables;
+			std::map<UINT, HREFTYPE> ImplementedTypes;
+			std::map<HREFTYPE, TypeReferenceTrace> References;
+		};
+
+		struct LibraryTrace
+		{
+			std::vector<std::string> FileNames;
+			std::wstring Path;
+			std::wstring Name;
+			TLIBATTR Attributes;
+			UINT TypeCount;
+			std::map<UINT, TypeTrace> Types;
+		};
+
+		class TypeLibraryTrace
+		{
+		private:
+			std::deque<LibraryTrace> libraries;
+			std::vector<std::unique_ptr<unsigned char[]>> blocks;
+
+		public:
+			TypeLibraryTrace() = default;
+			TypeLibraryTrace(TypeLibraryTrace&& rhs) = default;
+			TypeLibraryTrace(const TypeLibraryTrace& rhs) = delete;
+			~TypeLibraryTrace() = default;
+
+			TypeLibraryTrace& operator=(TypeLibraryTrace&& rhs) = default;
+			TypeLibraryTrace& operator=(const TypeLibraryTrace& rhs) = delete;
+
+			std::deque<LibraryTrace>& GetLibraries();
+			const std::deque<LibraryTrace>& GetLibraries() const;
+			LibraryTrace& AddLibrary(const TLIBATTR& attributes, UINT typeCount);
+
+			TYPEATTR CopyAttributes(const TYPEATTR& attributes);
+			FunctionTrace CopyFunction(const FUNCDESC& description);
+			VariableTrace CopyVariable(const VARDESC& description);
+			TYPEDESC CopyType(const TYPEDESC& description);
+			ELEMDESC CopyElement(const ELEMDESC& description);
+
+			void Save(const std::string& fileName) const;
+			static TypeLibraryTrace Load(const std::string& fileName);
+
+		private:
+			void* Allocate(std::size_t size);
+
+			static void WriteLibrary(std::ostream& out, const LibraryTrace& library);
+			static void WriteTypeInfo(std::ostream& out, const TypeTrace& type);
+			static void WriteFunction(std::ostream& out, const FunctionTrace& function);
+			static void WriteVariable(std::ostream& out, const VariableTrace& variable);
+			static void WriteElement(std::ostream& out, const ELEMDESC& description);
+			static void WriteType(std::ostream& out, const TYPEDESC& description);
+			static void WriteString(std::ostream& out, const std::string& value);
+			static void WriteWideString(std::ostream& out, const std::wstring& value);
+			static void WriteWord(std::ostream& out, std::uint16_t value);
+			static void WriteDword(std::ostream& out, std::uint32_t value);
+			static void WriteGuid(std::ostream& out, const GUID& value);
+
+			void ReadLibrary(std::istream& in, LibraryTrace& library);
+			void ReadTypeInfo(std::istream& in, TypeTrace& type);
+			void ReadFunction(std::istream& in, FunctionTrace& function);
+			void ReadVariable(std::istream& in, VariableTrace& variable);
+			void ReadElement(std::istream& in, ELEMDESC& description);
+			void ReadType(std::istream& in, TYPEDESC& description);
+			static std::string ReadString(std::istream& in);
+			static std::wstring ReadWideString(std::istream& in);
+			static std::uint16_t ReadWord(std::istream& in);
+			static std::uint32_t ReadDword(std::istream& in);
+			static GUID ReadGuid(std::istream& in);
+		};
+	}
+}
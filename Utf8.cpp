@@ -0,0 +1,243 @@
+#include "Utf8.h"
+#include <cstdint>
+#include <cwchar>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#define COM_IMPORT_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+#if (defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))) || defined(__AVX2__)
+#define COM_IMPORT_UTF8_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace Com
+{
+	namespace Import
+	{
+		namespace
+		{
+			const std::size_t stackBufferSize = 768;
+
+#ifdef COM_IMPORT_UTF8_SSE2
+			std::size_t ConvertAsciiSse2(const std::uint16_t* source, std::size_t length, char* destination)
+			{
+				const auto nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+				const auto zero = _mm_setzero_si128();
+				std::size_t index = 0;
+				for (; index + 16 <= length; index += 16)
+				{
+					auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+					auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index + 8));
+					auto bits = _mm_and_si128(_mm_or_si128(low, high), nonAscii);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(bits, zero)) != 0xFFFF)
+						break;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index), _mm_packus_epi16(low, high));
+				}
+				return index;
+			}
+#endif
+
+#ifdef COM_IMPORT_UTF8_AVX2
+			bool IsAvx2Supported()
+			{
+#ifdef _MSC_VER
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7)
+					return false;
+				const int osxsave = 1 << 27;
+				const int avx = 1 << 28;
+				__cpuid(info, 1);
+				if ((info[2] & (osxsave | avx)) != (osxsave | avx) || (_xgetbv(0) & 6) != 6)
+					return false;
+				__cpuidex(info, 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+#else
+				return true;
+#endif
+			}
+
+			const bool avx2Supported = IsAvx2Supported();
+
+			std::size_t ConvertAsciiAvx2(const std::uint16_t* source, std::size_t length, char* destination)
+			{
+				const auto nonAscii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+				std::size_t index = 0;
+				for (; index + 32 <= length; index += 32)
+				{
+					auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + index));
+					auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + index + 16));
+					if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAscii))
+						break;
+					// packus works within 128-bit lanes, so restore the order of the four 64-bit quarters.
+					auto packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + index), packed);
+				}
+				_mm256_zeroupper();
+				return index;
+			}
+#endif
+		}
+
+		Utf8::Result::Result()
+			: text(nullptr)
+		{
+		}
+
+		Utf8::Result::Result(Result&& rhs)
+			: text(rhs.text)
+		{
+			rhs.text = nullptr;
+		}
+
+		Utf8::Result::~Result()
+		{
+			::SysFreeString(text);
+		}
+
+		Utf8::Result::operator BSTR*()
+		{
+			return &text;
+		}
+
+		std::string Utf8::Result::ToString() const
+		{
+			return Utf8::ToString(text);
+		}
+
+		std::size_t Utf8::GetMaximumLength(std::size_t length)
+		{
+			// A UTF-16 unit never needs more than three bytes; a surrogate pair needs four for two units.
+			return length * (sizeof(wchar_t) == 2 ? 3 : 4);
+		}
+
+		std::size_t Utf8::Convert(const wchar_t* source, std::size_t length, char* destination)
+		{
+			auto converted = ConvertAscii(source, length, destination);
+			return converted + ConvertScalar(source + converted, length - converted, destination + converted);
+		}
+
+		std::size_t Utf8::ConvertScalar(const wchar_t* source, std::size_t length, char* destination)
+		{
+			auto out = destination;
+			for (std::size_t index = 0; index < length;)
+			{
+				auto code = static_cast<std::uint32_t>(source[index++]);
+				if (code < 0x80)
+				{
+					*out++ = static_cast<char>(code);
+					continue;
+				}
+				if (code < 0x800)
+				{
+					*out++ = static_cast<char>(0xC0 | (code >> 6));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+					continue;
+				}
+				if (code >= 0xD800 && code < 0xDC00 && index < length)
+				{
+					auto next = static_cast<std::uint32_t>(source[index]);
+					if (next >= 0xDC00 && next < 0xE000)
+					{
+						code = 0x10000 + ((code - 0xD800) << 10) + (next - 0xDC00);
+						++index;
+					}
+				}
+				if ((code >= 0xD800 && code < 0xE000) || code > 0x10FFFF)
+					code = 0xFFFD;
+				if (code < 0x10000)
+				{
+					*out++ = static_cast<char>(0xE0 | (code >> 12));
+					*out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else
+				{
+					*out++ = static_cast<char>(0xF0 | (code >> 18));
+					*out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+					*out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (code & 0x3F));
+				}
+			}
+			return out - destination;
+		}
+
+		std::string Utf8::ToString(const wchar_t* source, std::size_t length)
+		{
+			auto maximumLength = GetMaximumLength(length);
+			if (maximumLength <= stackBufferSize)
+			{
+				char buffer[stackBufferSize];
+				return{ buffer, Convert(source, length, buffer) };
+			}
+			std::string result(maximumLength, '\0');
+			result.resize(Convert(source, length, &result[0]));
+			return result;
+		}
+
+		std::string Utf8::ToString(BSTR source)
+		{
+			if (source == nullptr)
+				return{};
+			return ToString(source, ::SysStringLen(source));
+		}
+
+		std::u16string Utf8::ToUtf16(const std::string& source)
+		{
+			std::u16string result;
+			result.reserve(source.size());
+			for (std::size_t index = 0; index < source.size();)
+			{
+				auto lead = static_cast<unsigned char>(source[index++]);
+				if (lead < 0x80)
+				{
+					result.push_back(lead);
+					continue;
+				}
+				auto trailing = lead >= 0xF0 ? 3u : lead >= 0xE0 ? 2u : lead >= 0xC0 ? 1u : 0u;
+				std::uint32_t code = lead & (0x3F >> trailing);
+				auto valid = trailing > 0 && lead < 0xF5;
+				for (auto count = 0u; valid && count < trailing; ++count)
+				{
+					if (index == source.size() || (source[index] & 0xC0) != 0x80)
+						valid = false;
+					else
+						code = (code << 6) | (source[index++] & 0x3F);
+				}
+				if (!valid || (code >= 0xD800 && code < 0xE000) || code > 0x10FFFF)
+					code = 0xFFFD;
+				if (code < 0x10000)
+					result.push_back(static_cast<char16_t>(code));
+				else
+				{
+					result.push_back(static_cast<char16_t>(0xD800 + ((code - 0x10000) >> 10)));
+					result.push_back(static_cast<char16_t>(0xDC00 + ((code - 0x10000) & 0x3FF)));
+				}
+			}
+			return result;
+		}
+
+		std::size_t Utf8::ConvertAscii(const wchar_t* source, std::size_t length, char* destination)
+		{
+#if WCHAR_MAX == 0xFFFF
+			auto units = reinterpret_cast<const std::uint16_t*>(source);
+			std::size_t converted = 0;
+#ifdef COM_IMPORT_UTF8_AVX2
+			if (avx2Supported)
+				converted = ConvertAsciiAvx2(units, length, destination);
+#endif
+#ifdef COM_IMPORT_UTF8_SSE2
+			converted += ConvertAsciiSse2(units + converted, length - converted, destination + converted);
+#endif
+			return converted;
+#else
+			return 0;
+#endif
+		}
+	}
+}
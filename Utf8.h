@@ -0,0 +1,42 @@
+#pragma once
+#include <objbase.h>
+#include <cstddef>
+#include <string>
+
+namespace Com
+{
+	namespace Import
+	{
+		class Utf8
+		{
+		public:
+			// Receives a BSTR from a COM call; ToString converts it once the call has returned.
+			class Result
+			{
+			private:
+				BSTR text;
+
+			public:
+				Result();
+				Result(Result&& rhs);
+				Result(const Result& rhs) = delete;
+				~Result();
+
+				Result& operator=(const Result& rhs) = delete;
+
+				operator BSTR*();
+				std::string ToString() const;
+			};
+
+			static std::size_t GetMaximumLength(std::size_t length);
+			static std::size_t Convert(const wchar_t* source, std::size_t length, char* destination);
+			static std::size_t ConvertScalar(const wchar_t* source, std::size_t length, char* destination);
+			static std::string ToString(const wchar_t* source, std::size_t length);
+			static std::string ToString(BSTR source);
+			static std::u16string ToUtf16(const std::string& source);
+
+		private:
+			static std::size_t ConvertAscii(const wchar_t* source, std::size_t length, char* destination);
+		};
+	}
+}
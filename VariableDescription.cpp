@@ -1,6 +1,8 @@
 #include "VariableDescription.h"
 #include "TypeDescription.h"
 #include "ElementDescription.h"
+#include "Statistics.h"
+#include "Utf8.h"
 
 namespace Com
 {
@@ -9,6 +11,7 @@ namespace Com
 		VariableDescription::VariableDescription(const std::string& libraryName, Pointer<ITypeInfo2> typeInfo, UINT index)
 			: libraryName(libraryName), typeInfo(typeInfo)
 		{
+			COM_IMPORT_COUNT_CALL("GetVarDesc");
 			auto hr = typeInfo->GetVarDesc(index, &description);
 			CheckError(hr, __FUNCTION__, "GetVarDesc");
 		}
@@ -16,21 +19,26 @@ namespace Com
 		VariableDescription::~VariableDescription()
 		{
 			if (description != nullptr)
+			{
+				COM_IMPORT_COUNT_CALL("ReleaseVarDesc");
 				typeInfo->ReleaseVarDesc(description);
+			}
 		}
 
 		std::string VariableDescription::GetName() const
 		{
-			std::string name;
+			COM_IMPORT_ALLOCATION_SITE("VariableDescription::GetName");
+			Utf8::Result text;
 			UINT count = 0;
-			auto hr = typeInfo->GetNames(description->memid, Get(name), 1, &count);
+			COM_IMPORT_COUNT_CALL("GetNames");
+			auto hr = typeInfo->GetNames(description->memid, text, 1, &count);
 			CheckError(hr, __FUNCTION__, "GetNames");
 			if (count != 1)
 				throw std::runtime_error(__FUNCTION__ ": GetNames returned no name.");
-			return name;
+			return text.ToString();
 		}
 
-		long VariableDescription::GetValue() const
+		LONG VariableDescription::GetValue() const
 		{
 			Variant value;
 			auto hr = value.ChangeType(VT_I4, description->lpvarValue);
@@ -21,7 +21,7 @@ namespace Com
 			VariableDescription& operator=(const VariableDescription& rhs) = delete;
 
 			std::string GetName() const;
-			long GetValue() const;
+			LONG GetValue() const;
 			EnumValue ToEnumValue() const;
 			Parameter ToParameter() const;
 		};
@@ -1,6 +1,16 @@
+#include "CommandLine.h"
 #include "LibraryLoader.h"
+#include "LibraryDiff.h"
 #include "CodeGenerator.h"
+#include "LowMemoryImport.h"
+#include "AllocationTracker.h"
+#include "Statistics.h"
+#include "TraceEvents.h"
+#include "TypeLibraryRecorder.h"
+#include "TypeLibraryReplayer.h"
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 
 void DisplayHelp()
 {
@@ -12,37 +22,171 @@ void DisplayHelp()
 		<< "    Com.Import.exe example.tlb /implement" << std::endl
 		<< "    - This will generate the dll files for implementing this library and the import headers" << std::endl
 		<< "      for all cross-referenced libraries." << std::endl
+		<< std::endl
+		<< "Options:" << std::endl
+		<< "    --bstr-wrappers" << std::endl
+		<< "    - Adds wrapper overloads that take and return Com::Import::Strings::Bstr for string" << std::endl
+		<< "      parameters, passing BSTRs through without UTF-8 conversion. The std::string" << std::endl
+		<< "      wrappers are still generated." << std::endl
+		<< std::endl
+		<< "    --safearray-views" << std::endl
+		<< "    - Adds wrapper overloads that take and return Com::Import::SafeArrays::SafeArray<T> for" << std::endl
+		<< "      SAFEARRAYs of numbers. Inputs are copied in with one lock and outputs are read through" << std::endl
+		<< "      Access(), a span over SafeArrayAccessData. Combines with --bstr-wrappers." << std::endl
+		<< std::endl
+		<< "    --hresult-wrappers" << std::endl
+		<< "    - Adds a noexcept TryName wrapper next to every HRESULT method that returns the HRESULT" << std::endl
+		<< "      and takes the return value as an out reference, using the view types when enabled." << std::endl
+		<< std::endl
+		<< "    --diff old.tlb new.tlb" << std::endl
+		<< "    - Compares structural hashes of every interface, record and enum of the two libraries and" << std::endl
+		<< "      lists what was added, removed, extended by appending members, or changed in a way that" << std::endl
+		<< "      breaks binary compatibility. Exits with 1 when anything was removed or broken." << std::endl
+		<< std::endl
+		<< "    --emit-changed" << std::endl
+		<< "    - With --diff, also writes <OutputName>Changes.h, where <OutputName> is the output name of" << std::endl
+		<< "      the new library: its import header limited to the added and changed interfaces and the" << std::endl
+		<< "      interfaces they depend on. Referenced libraries are not imported, so include their" << std::endl
+		<< "      headers before <OutputName>Changes.h." << std::endl
+		<< std::endl
+		<< "    --low-memory" << std::endl
+		<< "    - Writes each import header as soon as its library is decoded and then releases the" << std::endl
+		<< "      library, keeping only the names needed for the project and dependency files." << std::endl
+		<< std::endl
+		<< "    --depfile example.d" << std::endl
+		<< "    - Writes a Makefile/Ninja dependency file listing every generated file as a target of" << std::endl
+		<< "      every type library that was read." << std::endl
+		<< std::endl
+		<< "    --stats" << std::endl
+		<< "    - Reports wall time per phase, COM calls by method, allocations and bytes written per" << std::endl
+		<< "      output file. Phases nest, so each is reported with its total time and with its self" << std::endl
+		<< "      time, which excludes the phases nested in it. Needs a build with COM_IMPORT_STATISTICS" << std::endl
+		<< "      defined, which the project does when built with msbuild /p:ComImportStatistics=true." << std::endl
+		<< std::endl
+		<< "    --trace example.json" << std::endl
+		<< "    - Writes Chrome/Perfetto trace events for every library import, type decode and" << std::endl
+		<< "      generated file, tagged with the thread that produced them." << std::endl
+		<< std::endl
+		<< "    --allocations example.tsv" << std::endl
+		<< "    - Writes allocation counts and bytes attributed to the active phase and call site as" << std::endl
+		<< "      tab-separated values sorted by phase, so reports from two versions can be diffed." << std::endl
+		<< "      Needs the same COM_IMPORT_STATISTICS build as --stats." << std::endl
+		<< std::endl
+		<< "    --record example.trace" << std::endl
+		<< "    - Records every type library query made during the import into a trace file." << std::endl
+		<< std::endl
+		<< "    --replay example.trace" << std::endl
+		<< "    - Serves every type library query from a recorded trace file instead of OLE Automation," << std::endl
+		<< "      so no type library needs to be present or registered." << std::endl
 		<< std::endl;
 }
 
-void LoadTypeLibrary(const std::string& fileName, bool implement = false)
+void GenerateTypeLibrary(const Com::Import::Options& options)
+{
+	Com::Import::LoadLibraryResult result;
+	Com::Import::CodeGenerator generator;
+	if (options.LowMemory)
+	{
+		Com::Import::LowMemoryImport::Load(options.TypeLibraryFileName, options.Generator, generator, result);
+		COM_IMPORT_TIME_PHASE("format and write");
+		generator.GenerateImplementation(result, options.Generator);
+	}
+	else
+	{
+		{
+			COM_IMPORT_TIME_PHASE("load");
+			Com::Import::LibraryLoader loader;
+			result = loader.Load(options.TypeLibraryFileName);
+		}
+		generator.Generate(result, options.Generator);
+	}
+	if (!options.DependencyFileName.empty())
+		generator.GenerateDependencies(options.DependencyFileName, result);
+}
+
+int DiffTypeLibraries(const Com::Import::Options& options)
+{
+	// Only the two libraries themselves are compared, so their references are not imported.
+	Com::Import::Library oldLibrary;
+	Com::Import::Library newLibrary;
+	{
+		COM_IMPORT_TIME_PHASE("load");
+		{
+			Com::Import::LibraryLoader loader;
+			oldLibrary = loader.LoadPrimary(options.DiffOldFileName);
+		}
+		{
+			Com::Import::LibraryLoader loader;
+			newLibrary = loader.LoadPrimary(options.DiffNewFileName);
+		}
+	}
+
+	COM_IMPORT_TIME_PHASE("diff");
+	Com::Import::LibraryDiff diff{ oldLibrary, newLibrary };
+	std::cout << "Comparing: " << options.DiffOldFileName << " -> " << options.DiffNewFileName << std::endl;
+	diff.Report(std::cout);
+	if (options.EmitChanged)
+	{
+		Com::Import::CodeGenerator generator;
+		generator.GenerateImport(
+			diff.SelectChangedInterfaces(newLibrary),
+			Com::Import::CodeGenerator::GetReferenceOptions(options.Generator));
+	}
+	return diff.IsBreaking() ? 1 : 0;
+}
+
+int LoadTypeLibrary(const Com::Import::Options& options)
 {
-	Com::Import::LibraryLoader loader;
-	auto result = loader.Load(fileName);
-	Com::Import::CodeGenerator::Generate(result, implement);
+	std::unique_ptr<Com::Import::TypeLibraryRecorder> recorder;
+	std::unique_ptr<Com::Import::TypeLibraryReplayer> replayer;
+	if (!options.RecordFileName.empty())
+		recorder.reset(new Com::Import::TypeLibraryRecorder);
+	else if (!options.ReplayFileName.empty())
+		replayer.reset(new Com::Import::TypeLibraryReplayer{ Com::Import::TypeLibraryTrace::Load(options.ReplayFileName) });
+
+	if (options.ReportStatistics)
+		Com::Import::Statistics::Enable();
+	if (!options.TraceFileName.empty())
+		Com::Import::TraceEvents::Enable();
+	if (!options.AllocationsFileName.empty())
+		Com::Import::AllocationTracker::Enable();
+
+	auto exitCode = 0;
+	if (!options.DiffOldFileName.empty())
+		exitCode = DiffTypeLibraries(options);
+	else
+		GenerateTypeLibrary(options);
+	if (recorder)
+		recorder->Save(options.RecordFileName);
+
+	if (!options.TraceFileName.empty())
+		Com::Import::TraceEvents::Write(options.TraceFileName);
+	if (!options.AllocationsFileName.empty())
+	{
+		if (!Com::Import::Statistics::IsAvailable())
+			std::cout << "Allocation tracking is not available; build with COM_IMPORT_STATISTICS defined." << std::endl;
+		Com::Import::AllocationTracker::Write(options.AllocationsFileName);
+	}
+	if (options.ReportStatistics)
+		Com::Import::Statistics::Report(std::cout);
+	return exitCode;
 }
 
 int main(int argc, char** argv)
 {
+	auto exitCode = 0;
 	try
 	{
-		switch (argc)
-		{
-		case 2:
-			LoadTypeLibrary(argv[1]);
-			break;
-		case 3:
-			LoadTypeLibrary(argv[1], std::strcmp(argv[2], "/implement") == 0);
-			break;
-		default:
+		Com::Import::Options options;
+		if (!Com::Import::CommandLine::TryParse(argc, argv, options))
 			DisplayHelp();
-			break;
-		}
+		else
+			exitCode = LoadTypeLibrary(options);
 	}
 	catch (const std::exception& exception)
 	{
 		std::cerr << exception.what() << std::endl;
 		return -1;
 	}
-	return 0;
+	return exitCode;
 }